@@ -0,0 +1,71 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "dual_sense_hid/calibration.hpp"
+#include "dual_sense_hid/orientation.hpp"
+
+
+using namespace dual_sense_hid;
+
+namespace
+{
+	constexpr size_t SAMPLE_COUNT = 1'000'000;
+	constexpr uint64_t REPORT_INTERVAL_US = 1000;
+
+	struct Sample
+	{
+		State::Gyro gyro;
+		State::Acceleration acceleration;
+	};
+
+	std::vector<Sample> make_samples()
+	{
+		std::vector<Sample> samples(SAMPLE_COUNT);
+		for(size_t i = 0; i < samples.size(); ++i)
+		{
+			const auto phase = static_cast<int32_t>(i % 1000) - 500;
+			samples[i] = {
+					{phase * 40, 30 * Calibration::GYROSCOPE_RESOLUTION, -phase * 25},
+					{phase * 3, 1200, Calibration::ACCELEROMETER_RESOLUTION}
+			};
+		}
+
+		return samples;
+	}
+
+	template<typename Filter>
+	void run(const char* name, const std::vector<Sample>& samples)
+	{
+		Filter filter;
+
+		const auto start = std::chrono::steady_clock::now();
+		for(const auto& sample: samples)
+		{
+			filter.update(sample.gyro, sample.acceleration, REPORT_INTERVAL_US);
+		}
+		const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+
+		const auto orientation = filter.orientation();
+		std::cout << fmt::format(
+				"{:<20} {:>8.1f} ns/sample   q = ({:.4f}, {:.4f}, {:.4f}, {:.4f})\n",
+				name,
+				elapsed.count() / static_cast<double>(samples.size()),
+				orientation.w, orientation.x, orientation.y, orientation.z
+		);
+	}
+}
+
+int main()
+{
+	const auto samples = make_samples();
+
+	std::cout << fmt::format("Orientation fusion cost over {} samples:\n", samples.size());
+	run<MadgwickFilter>("float", samples);
+	run<FixedMadgwickFilter>("fixed point", samples);
+
+	return 0;
+}
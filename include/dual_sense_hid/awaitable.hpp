@@ -0,0 +1,67 @@
+#ifndef DUAL_SENSE_HID_AWAITABLE_HPP
+#define DUAL_SENSE_HID_AWAITABLE_HPP
+
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+
+#include "state.hpp"
+
+
+namespace dual_sense_hid
+{
+	class Gamepad;
+
+	/**
+	 * @brief Executor used to resume coroutine waiting for report
+	 *
+	 * Called from thread decoding reports. Empty executor resumes coroutine inline on that thread.
+	 */
+	using Executor = std::function<void(std::coroutine_handle<>)>;
+
+	namespace detail
+	{
+		struct StateWaiter
+		{
+			uint32_t buttons;
+			bool any_report;
+			std::coroutine_handle<> handle;
+			Executor executor;
+			State* result;
+		};
+	}
+
+	/**
+	 * @brief Awaitable resumed with state of next matching report
+	 * @see Gamepad::next_state
+	 * @see Gamepad::next_change
+	 */
+	class StateAwaitable
+	{
+	public:
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		void await_suspend(std::coroutine_handle<> handle);
+
+		State await_resume() const noexcept
+		{
+			return state_;
+		}
+
+	private:
+		StateAwaitable(Gamepad& gamepad, uint32_t buttons, bool any_report, Executor executor);
+
+		Gamepad& gamepad_;
+		uint32_t buttons_;
+		bool any_report_;
+		Executor executor_;
+		State state_{};
+
+		friend class Gamepad;
+	};
+}
+
+#endif //DUAL_SENSE_HID_AWAITABLE_HPP
@@ -0,0 +1,108 @@
+#ifndef DUAL_SENSE_HID_BATCH_DECODER_HPP
+#define DUAL_SENSE_HID_BATCH_DECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "calibration.hpp"
+#include "enums.hpp"
+#include "detail/calibration_kernel.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Structure-of-arrays destination of batch decoding
+	 *
+	 * Element i of every array receives value decoded from report i.
+	 * Each span has to hold at least as many elements as there are reports decoded.
+	 */
+	struct MotionBatch
+	{
+		std::span<int32_t> gyro_pitch; /*!< Gyroscope pitch */
+		std::span<int32_t> gyro_yaw; /*!< Gyroscope yaw */
+		std::span<int32_t> gyro_roll; /*!< Gyroscope roll */
+
+		std::span<int32_t> acceleration_x; /*!< Accelerometer X axis */
+		std::span<int32_t> acceleration_y; /*!< Accelerometer Y axis */
+		std::span<int32_t> acceleration_z; /*!< Accelerometer Z axis */
+
+		std::span<uint8_t> left_pad_x; /*!< Left stick X position */
+		std::span<uint8_t> left_pad_y; /*!< Left stick Y position */
+		std::span<uint8_t> right_pad_x; /*!< Right stick X position */
+		std::span<uint8_t> right_pad_y; /*!< Right stick Y position */
+
+		std::span<uint8_t> left_trigger; /*!< Left trigger position */
+		std::span<uint8_t> right_trigger; /*!< Right trigger position */
+	};
+
+	/**
+	 * @brief Decoder of recorded input reports into structure-of-arrays buffers
+	 *
+	 * Uses AVX2 when supported by CPU (checked at runtime), scalar code otherwise.
+	 * @see RawReport
+	 */
+	class BatchDecoder
+	{
+	public:
+		/**
+		 * @brief Create decoder of uncalibrated readings
+		 * @param connection_type Type of connection reports were received with
+		 */
+		explicit BatchDecoder(ConnectionType connection_type);
+
+		/**
+		 * @brief Create decoder applying calibration to gyroscope & accelerometer readings
+		 * @param connection_type Type of connection reports were received with
+		 * @param calibration Calibration data of gamepad which sent reports
+		 */
+		BatchDecoder(ConnectionType connection_type, const Calibration& calibration);
+
+		/**
+		 * @brief Decode contiguous reports
+		 * @param reports Reports laid out back to back (64 bytes each for USB, 78 bytes for Bluetooth)
+		 * @param out Destination buffers
+		 * @return Number of decoded reports
+		 */
+		std::size_t decode(std::span<const uint8_t> reports, const MotionBatch& out) const;
+
+		/**
+		 * @brief Get size of single report
+		 * @return Size of single report in bytes
+		 */
+		[[nodiscard]] std::size_t report_size() const;
+
+		/**
+		 * @brief Check if vectorized decoding is used
+		 * @return true if CPU supports AVX2
+		 */
+		[[nodiscard]] static bool simd_supported();
+
+	private:
+		ConnectionType connection_type_;
+		std::optional<detail::CalibrationKernel> calibration_;
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Reports layout and calibration passed to batch kernels
+		 */
+		struct BatchLayout
+		{
+			const uint8_t* common; /*!< Common part of first report */
+			std::size_t stride; /*!< Distance between reports */
+			const CalibrationKernel* calibration; /*!< Calibration or nullptr */
+		};
+
+		void decode_batch_scalar(const BatchLayout& layout, std::size_t first, std::size_t count, const MotionBatch& out);
+		/**
+		 * @return Index of first report left undecoded (multiple of 8)
+		 */
+		std::size_t decode_batch_avx2(const BatchLayout& layout, std::size_t count, const MotionBatch& out);
+	}
+}
+
+#endif //DUAL_SENSE_HID_BATCH_DECODER_HPP
@@ -0,0 +1,74 @@
+#ifndef DUAL_SENSE_HID_CALIBRATION_CACHE_HPP
+#define DUAL_SENSE_HID_CALIBRATION_CACHE_HPP
+
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <string>
+
+#include "calibration.hpp"
+#include "device_info.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief On-disk cache of gamepads calibration data keyed by serial number
+	 *
+	 * Each gamepad is stored in separate small binary file validated by version and checksum.
+	 * Missing, outdated or corrupted entries are treated as cache misses.
+	 * @see Gamepad::Gamepad(const DeviceInfo&, const CalibrationCache&)
+	 */
+	class CalibrationCache
+	{
+	public:
+		/**
+		 * @brief Constructor
+		 * @param directory Directory holding cache entries. Created on first store
+		 */
+		explicit CalibrationCache(std::filesystem::path directory);
+
+		/**
+		 * @brief Load cached calibration data
+		 * @param serial Serial number of gamepad
+		 * @return Calibration data or std::nullopt if there is no valid entry
+		 */
+		[[nodiscard]] std::optional<Calibration> load(const std::string& serial) const;
+
+		/**
+		 * @brief Store calibration data
+		 * @param serial Serial number of gamepad
+		 * @param calibration Calibration data to store
+		 * @return false if entry couldn't be written
+		 */
+		bool store(const std::string& serial, const Calibration& calibration) const;
+
+		/**
+		 * @brief Remove cached calibration data
+		 * @param serial Serial number of gamepad
+		 */
+		void invalidate(const std::string& serial) const;
+
+		/**
+		 * @brief Fetch calibration data from device in background and update cache entry
+		 *
+		 * Device is opened with separate handle, so gamepad may be used meanwhile.
+		 * @param device_info Device to fetch calibration data from
+		 * @return Future holding fetched calibration data or exception if fetching failed
+		 */
+		[[nodiscard]] std::future<Calibration> refresh(const DeviceInfo& device_info) const;
+
+		/**
+		 * @brief Get cache directory
+		 * @return Cache directory
+		 */
+		[[nodiscard]] const std::filesystem::path& directory() const;
+
+	private:
+		[[nodiscard]] std::filesystem::path entry_path(const std::string& serial) const;
+
+		std::filesystem::path directory_;
+	};
+}
+
+#endif //DUAL_SENSE_HID_CALIBRATION_CACHE_HPP
@@ -0,0 +1,72 @@
+#ifndef DUAL_SENSE_HID_COMPACT_STATE_HPP
+#define DUAL_SENSE_HID_COMPACT_STATE_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "enums.hpp"
+#include "state.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Tightly packed representation of State fitting in single cache line
+	 *
+	 * All buttons (including DigitalPad) are stored as single mask indexed by Button.
+	 * @note Conversion from State is lossless for every valid DPadDirection
+	 */
+	struct CompactState
+	{
+		uint64_t sensor_timestamp; /*!< Device sensor time in microseconds */
+		uint64_t host_timestamp; /*!< Host reception time in microseconds */
+
+		std::array<int32_t, 3> gyro; /*!< Gyroscope state (pitch, yaw, roll) */
+		std::array<int32_t, 3> acceleration; /*!< Accelerometer state (x, y, z) */
+
+		uint32_t buttons; /*!< Mask of pressed buttons */
+
+		/**
+		 * @brief Touch points packed as: x (bits 0-11), y (bits 12-23), id (bits 24-30), active (bit 31)
+		 */
+		std::array<uint32_t, 2> touch_points;
+
+		std::array<uint8_t, 4> sticks; /*!< Analog pads state (left x, left y, right x, right y) */
+		std::array<uint8_t, 2> triggers; /*!< Triggers position (left, right) */
+		uint8_t trigger_stop_locations; /*!< Triggers stop location: left (bits 0-3), right (bits 4-7) */
+
+		uint8_t temperature; /*!< Gamepad temperature */
+		uint8_t battery; /*!< Battery level (bits 0-3) and power status (bits 4-7) */
+		uint8_t audio; /*!< Audio flags: muted (bit 0), headphones (bit 1), microphone (bit 2) */
+		uint8_t touch_timestamp; /*!< Touchpad sampling counter */
+
+		/**
+		 * @brief Check if button is pressed
+		 * @param button Button to check
+		 * @return true if button is pressed
+		 */
+		[[nodiscard]] constexpr bool pressed(Button button) const
+		{
+			return (buttons & button_mask(button)) != 0;
+		}
+
+		/**
+		 * @brief Pack state
+		 * @param state State to pack
+		 * @return Packed state
+		 */
+		[[nodiscard]] static CompactState from_state(const State& state);
+
+		/**
+		 * @brief Unpack state
+		 * @return Unpacked state
+		 */
+		[[nodiscard]] State to_state() const;
+
+		bool operator==(const CompactState&) const = default;
+	};
+
+	static_assert(sizeof(CompactState) <= 64);
+}
+
+#endif //DUAL_SENSE_HID_COMPACT_STATE_HPP
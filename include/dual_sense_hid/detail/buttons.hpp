@@ -0,0 +1,36 @@
+#ifndef DUAL_SENSE_HID_BUTTONS_HPP
+#define DUAL_SENSE_HID_BUTTONS_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "../enums.hpp"
+#include "report_input.hpp"
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief DigitalPad bits of button mask indexed by DPadDirection
+	 */
+	static constexpr std::array<uint8_t, 16> DPAD_DIRECTION_MASK {
+			0b0001, 0b0011, 0b0010, 0b0110, 0b0100, 0b1100, 0b1000, 0b1001,
+			0, 0, 0, 0, 0, 0, 0, 0
+	};
+
+	/**
+	 * @brief Build button mask from packed report bits
+	 *
+	 * Non-DPad buttons in report are already laid out as in Button, so only DPad needs translation.
+	 */
+	inline uint32_t button_mask(const ReportButtons& buttons)
+	{
+		const auto bytes = std::bit_cast<std::array<uint8_t, sizeof(ReportButtons)>>(buttons);
+		const auto raw = static_cast<uint32_t>(bytes[0] | (bytes[1] << 8) | (bytes[2] << 16));
+
+		return (raw & 0x7fff0u) | DPAD_DIRECTION_MASK[raw & 0x0fu];
+	}
+}
+
+#endif //DUAL_SENSE_HID_BUTTONS_HPP
@@ -0,0 +1,89 @@
+#ifndef DUAL_SENSE_HID_CALIBRATION_KERNEL_HPP
+#define DUAL_SENSE_HID_CALIBRATION_KERNEL_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "../calibration.hpp"
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief Exact integer calibration, equal to trunc(value * numerator / denominator)
+	 * @note Remainder of division multiplied by numerator has to fit in T
+	 */
+	template<typename T>
+	requires std::integral<T>
+	inline T mult_frac(T value, T numerator, T denominator)
+	{
+		return (value / denominator) * numerator + ((value % denominator) * numerator) / denominator;
+	}
+
+	/**
+	 * @brief Division-free calibration of all motion axes at once
+	 *
+	 * Lanes hold gyroscope pitch, yaw, roll followed by accelerometer x, y, z. Remaining lanes pad
+	 * arrays to 8 floats, so loops map to single AVX (or two SSE) operations.
+	 * @note Results agree with mult_frac within 1 unit
+	 */
+	struct CalibrationKernel
+	{
+		static constexpr size_t LANES = 8;
+
+		alignas(32) std::array<float, LANES> offset{};
+		alignas(32) std::array<float, LANES> scale{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+		/**
+		 * @brief Precompute offsets and scales
+		 * @note Axes with zero calibration range are passed through uncalibrated
+		 */
+		static CalibrationKernel from_calibration(const Calibration& calibration)
+		{
+			const auto& gyro = calibration.gyroscope;
+			const auto& accel = calibration.accelerometer;
+
+			const std::array<int32_t, 6> offsets = {
+					gyro.pitch_offset, gyro.yaw_offset, gyro.roll_offset,
+					accel.x_offset, accel.y_offset, accel.z_offset
+			};
+			const std::array<int32_t, 6> numerators = {
+					gyro.factor_numerator, gyro.factor_numerator, gyro.factor_numerator,
+					accel.factor_numerator, accel.factor_numerator, accel.factor_numerator
+			};
+			const std::array<int32_t, 6> denominators = {
+					gyro.pitch_factor_denominator, gyro.yaw_factor_denominator, gyro.roll_factor_denominator,
+					accel.x_factor_denominator, accel.y_factor_denominator, accel.z_factor_denominator
+			};
+
+			CalibrationKernel kernel;
+			for(size_t i = 0; i < offsets.size(); ++i)
+			{
+				if(denominators[i] == 0)
+				{
+					continue;
+				}
+
+				kernel.offset[i] = static_cast<float>(offsets[i]);
+				kernel.scale[i] = static_cast<float>(static_cast<double>(numerators[i]) / denominators[i]);
+			}
+
+			return kernel;
+		}
+
+		[[nodiscard]] std::array<int32_t, LANES> apply(const std::array<int32_t, LANES>& axes) const
+		{
+			std::array<int32_t, LANES> calibrated;
+			for(size_t i = 0; i < LANES; ++i)
+			{
+				calibrated[i] = static_cast<int32_t>((static_cast<float>(axes[i]) - offset[i]) * scale[i]);
+			}
+
+			return calibrated;
+		}
+	};
+}
+
+#endif //DUAL_SENSE_HID_CALIBRATION_KERNEL_HPP
@@ -0,0 +1,16 @@
+#ifndef DUAL_SENSE_HID_CALIBRATION_REPORT_HPP
+#define DUAL_SENSE_HID_CALIBRATION_REPORT_HPP
+
+#include "../calibration.hpp"
+#include "transport.hpp"
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief Read calibration feature report from device and decode it
+	 */
+	Calibration fetch_calibration(Transport& transport);
+}
+
+#endif //DUAL_SENSE_HID_CALIBRATION_REPORT_HPP
@@ -3,12 +3,13 @@
 
 #include <cstdint>
 #include <bit>
+#include <string>
 
 
 namespace dual_sense_hid::detail
 {
 #if defined(__cpp_lib_byteswap)
-	uint16_t dual_sense_bswap16(uint16_t val)
+	inline uint16_t dual_sense_bswap16(uint16_t val)
 	{
 		return std::byteswap(val);
 	}
@@ -16,7 +17,7 @@ namespace dual_sense_hid::detail
 using dual_sense_bswap16 = _byteswap_ushort;
 #elif defined(__has_builtin)
 	#if __has_builtin(__builtin_bswap16)
-		uint16_t dual_sense_bswap16(uint16_t val)
+		inline uint16_t dual_sense_bswap16(uint16_t val)
 		{
 			return __builtin_bswap16(val);
 		}
@@ -41,19 +42,83 @@ inline uint16_t le_to_native(uint16_t le)
 	}
 }
 
-	std::string wstring_to_string(const std::wstring &input)
+	/**
+	 * @brief Convert wide string (UTF-32, or UTF-16 where wchar_t is 16-bit) to UTF-8
+	 *
+	 * Reuses capacity of output, so repeated conversions into same string don't allocate.
+	 * Invalid code units are replaced by U+FFFD.
+	 * @param input Null-terminated wide string (nullptr is treated as empty)
+	 * @param output String receiving converted characters
+	 */
+	inline void wide_to_utf8(const wchar_t* input, std::string& output)
 	{
-		auto &facet = std::use_facet<std::codecvt<wchar_t, char, std::mbstate_t>>(std::locale());
-		std::mbstate_t mb{};
+		constexpr uint32_t REPLACEMENT_CHARACTER = 0xfffd;
+
+		output.clear();
+		if(input == nullptr)
+		{
+			return;
+		}
 
-		std::string output(input.size() * static_cast<size_t>(facet.max_length()), '\0');
+		for(; *input != L'\0'; ++input)
+		{
+			auto code_point = static_cast<uint32_t>(*input);
 
-		const wchar_t *from_next;
-		char *to_next;
+			if constexpr(sizeof(wchar_t) == 2)
+			{
+				if(code_point >= 0xd800 && code_point < 0xe000)
+				{
+					const auto low = static_cast<uint32_t>(input[1]);
+					if(code_point < 0xdc00 && low >= 0xdc00 && low < 0xe000)
+					{
+						code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+						++input;
+					}
+					else
+					{
+						code_point = REPLACEMENT_CHARACTER;
+					}
+				}
+			}
+			else if((code_point >= 0xd800 && code_point < 0xe000) || code_point >= 0x110000)
+			{
+				code_point = REPLACEMENT_CHARACTER;
+			}
 
-		facet.out(mb, &input[0], &input[input.size()], from_next, &output[0], &output[output.size()], to_next);
+			if(code_point < 0x80)
+			{
+				output.push_back(static_cast<char>(code_point));
+			}
+			else if(code_point < 0x800)
+			{
+				output.push_back(static_cast<char>(0xc0 | (code_point >> 6)));
+				output.push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+			}
+			else if(code_point < 0x10000)
+			{
+				output.push_back(static_cast<char>(0xe0 | (code_point >> 12)));
+				output.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+				output.push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+			}
+			else
+			{
+				output.push_back(static_cast<char>(0xf0 | (code_point >> 18)));
+				output.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3f)));
+				output.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+				output.push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+			}
+		}
+	}
 
-		output.resize(static_cast<size_t>(to_next - &output[0]));
+	/**
+	 * @brief Convert wide string to UTF-8
+	 * @param input Null-terminated wide string (nullptr is treated as empty)
+	 * @return Converted string
+	 */
+	inline std::string wide_to_utf8(const wchar_t* input)
+	{
+		std::string output;
+		wide_to_utf8(input, output);
 
 		return output;
 	}
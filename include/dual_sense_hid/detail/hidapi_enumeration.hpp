@@ -0,0 +1,39 @@
+#ifndef DUAL_SENSE_HID_DETAIL_HIDAPI_ENUMERATION_HPP
+#define DUAL_SENSE_HID_DETAIL_HIDAPI_ENUMERATION_HPP
+
+#include <functional>
+
+#include "../device_info.hpp"
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief Gamepad listed by hidapi. Pointers are valid only during visit
+	 */
+	struct EnumeratedDevice
+	{
+		const char* path;
+		const wchar_t* serial;
+		const wchar_t* manufacturer_string;
+		const wchar_t* product_string;
+		ConnectionType connection_type;
+	};
+
+	/**
+	 * @brief Visit gamepads currently listed by hidapi
+	 *
+	 * Enumeration list is released afterwards, also when visitor throws.
+	 * @param visitor Function called for every gamepad
+	 */
+	void visit_hidapi_devices(const std::function<void(const EnumeratedDevice&)>& visitor);
+
+	/**
+	 * @brief Build owning device info from enumerated gamepad
+	 * @param device Enumerated gamepad
+	 * @return Device info with UTF-8 strings
+	 */
+	DeviceInfo to_device_info(const EnumeratedDevice& device);
+}
+
+#endif //DUAL_SENSE_HID_DETAIL_HIDAPI_ENUMERATION_HPP
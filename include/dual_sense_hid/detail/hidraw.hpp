@@ -0,0 +1,20 @@
+#ifndef DUAL_SENSE_HID_DETAIL_HIDRAW_HPP
+#define DUAL_SENSE_HID_DETAIL_HIDRAW_HPP
+
+#include <optional>
+#include <string_view>
+
+#include "../device_info.hpp"
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief Build device info of hidraw node from sysfs
+	 * @param node_name Name of hidraw node (e.g. hidraw3)
+	 * @return Device info or empty optional if node is not a DualSense gamepad
+	 */
+	std::optional<DeviceInfo> read_hidraw_device_info(std::string_view node_name);
+}
+
+#endif //DUAL_SENSE_HID_DETAIL_HIDRAW_HPP
@@ -62,7 +62,7 @@ namespace dual_sense_hid::detail
 		uint16_t acceleration_y;
 		uint16_t acceleration_z;
 
-		uint8_t gap_2[4];
+		uint8_t sensor_timestamp[4]; // 1/3 us resolution
 		uint8_t temperature;
 
 		uint8_t touch_data_0[4];
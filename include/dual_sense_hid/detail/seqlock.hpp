@@ -0,0 +1,77 @@
+#ifndef DUAL_SENSE_HID_SEQLOCK_HPP
+#define DUAL_SENSE_HID_SEQLOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "spsc_ring.hpp"
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief Single-writer/multi-reader slot holding latest value
+	 * @note Readers never block writer and always observe a value which is not torn.
+	 * Payload is kept in relaxed atomic words, so concurrent access is race-free.
+	 */
+	template<typename T>
+	requires std::is_trivially_copyable_v<T>
+	class Seqlock
+	{
+	public:
+		void store(const T& value)
+		{
+			std::array<uint64_t, WORD_COUNT> words{};
+			std::memcpy(words.data(), &value, sizeof(T));
+
+			const auto sequence = sequence_.load(std::memory_order_relaxed);
+			sequence_.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			for(size_t i = 0; i < WORD_COUNT; ++i)
+			{
+				words_[i].store(words[i], std::memory_order_relaxed);
+			}
+
+			sequence_.store(sequence + 2, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Read latest value
+		 * @return false if no value was stored yet
+		 */
+		bool load(T& value) const
+		{
+			std::array<uint64_t, WORD_COUNT> words;
+			uint64_t before;
+			uint64_t after;
+
+			do
+			{
+				before = sequence_.load(std::memory_order_acquire);
+				for(size_t i = 0; i < WORD_COUNT; ++i)
+				{
+					words[i] = words_[i].load(std::memory_order_relaxed);
+				}
+				std::atomic_thread_fence(std::memory_order_acquire);
+				after = sequence_.load(std::memory_order_relaxed);
+			}
+			while(before != after || (before & 1) != 0);
+
+			std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+
+			return before != 0;
+		}
+
+	private:
+		static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> sequence_ = 0;
+		std::array<std::atomic<uint64_t>, WORD_COUNT> words_{};
+	};
+}
+
+#endif //DUAL_SENSE_HID_SEQLOCK_HPP
@@ -0,0 +1,77 @@
+#ifndef DUAL_SENSE_HID_SPSC_RING_HPP
+#define DUAL_SENSE_HID_SPSC_RING_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
+
+namespace dual_sense_hid::detail
+{
+	static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+	/**
+	 * @brief Fixed-capacity lock-free single-producer/single-consumer ring
+	 * @note try_push may be called only from one thread and try_pop only from one (other) thread
+	 */
+	template<typename T, std::size_t Capacity>
+	requires (std::has_single_bit(Capacity))
+	class SpscRing
+	{
+	public:
+		bool try_push(const T& value)
+		{
+			const auto tail = tail_.load(std::memory_order_relaxed);
+			if(tail - cached_head_ == Capacity)
+			{
+				cached_head_ = head_.load(std::memory_order_acquire);
+				if(tail - cached_head_ == Capacity)
+				{
+					return false;
+				}
+			}
+
+			buffer_[tail & MASK] = value;
+			tail_.store(tail + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		bool try_pop(T& value)
+		{
+			const auto head = head_.load(std::memory_order_relaxed);
+			if(head == cached_tail_)
+			{
+				cached_tail_ = tail_.load(std::memory_order_acquire);
+				if(head == cached_tail_)
+				{
+					return false;
+				}
+			}
+
+			value = buffer_[head & MASK];
+			head_.store(head + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		[[nodiscard]] std::size_t size() const
+		{
+			return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+		}
+
+	private:
+		static constexpr std::size_t MASK = Capacity - 1;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_ = 0;
+		std::size_t cached_tail_ = 0;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_ = 0;
+		std::size_t cached_head_ = 0;
+
+		alignas(CACHE_LINE_SIZE) std::array<T, Capacity> buffer_{};
+	};
+}
+
+#endif //DUAL_SENSE_HID_SPSC_RING_HPP
@@ -0,0 +1,56 @@
+#ifndef DUAL_SENSE_HID_TIMESTAMP_HPP
+#define DUAL_SENSE_HID_TIMESTAMP_HPP
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief Sensor timestamp resolution (ticks per microsecond)
+	 */
+	static constexpr uint64_t SENSOR_TICKS_PER_US = 3;
+
+	/**
+	 * @brief Extender of 32-bit wrapping device counter to monotonic 64-bit value
+	 * @note Counter has to be fed at least once per wraparound period
+	 */
+	class TimestampExtender
+	{
+	public:
+		uint64_t extend(uint32_t raw)
+		{
+			if(!initialized_)
+			{
+				extended_ = raw;
+				initialized_ = true;
+			}
+			else
+			{
+				// unsigned difference handles wraparound
+				extended_ += raw - last_;
+			}
+			last_ = raw;
+
+			return extended_;
+		}
+
+	private:
+		bool initialized_ = false;
+		uint32_t last_ = 0;
+		uint64_t extended_ = 0;
+	};
+
+	/**
+	 * @brief Get host time used to stamp received reports
+	 * @return Steady clock time in microseconds
+	 */
+	inline uint64_t host_timestamp()
+	{
+		const auto now = std::chrono::steady_clock::now().time_since_epoch();
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+	}
+}
+
+#endif //DUAL_SENSE_HID_TIMESTAMP_HPP
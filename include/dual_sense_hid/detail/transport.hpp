@@ -0,0 +1,61 @@
+#ifndef DUAL_SENSE_HID_TRANSPORT_HPP
+#define DUAL_SENSE_HID_TRANSPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "../enums.hpp"
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief Raw report I/O of single opened device
+	 */
+	class Transport
+	{
+	public:
+		virtual ~Transport() = default;
+
+		/**
+		 * @brief Read input report
+		 * @param timeout_ms Maximum wait time. 0 - don't block, -1 - block until report arrives
+		 * @return Number of bytes read, 0 on timeout, negative on error
+		 */
+		virtual int read(uint8_t* buffer, std::size_t size, int timeout_ms) = 0;
+
+		/**
+		 * @brief Write output report
+		 * @return Number of bytes written, negative on error
+		 */
+		virtual int write(const uint8_t* buffer, std::size_t size) = 0;
+
+		/**
+		 * @brief Get feature report. First byte of buffer holds report id
+		 * @return Number of bytes read, negative on error
+		 */
+		virtual int get_feature_report(uint8_t* buffer, std::size_t size) = 0;
+
+		/**
+		 * @brief Get pollable file descriptor of device
+		 * @return File descriptor or -1 if transport doesn't expose it
+		 */
+		[[nodiscard]] virtual int native_handle() const = 0;
+	};
+
+	/**
+	 * @brief Open device with transport of given backend
+	 * @throws std::runtime_error if device can't be opened or backend isn't supported on platform
+	 */
+	std::unique_ptr<Transport> open_transport(const std::string& path, Backend backend);
+
+	std::unique_ptr<Transport> open_hidapi_transport(const std::string& path);
+
+#if defined(__linux__)
+	std::unique_ptr<Transport> open_hidraw_transport(const std::string& path);
+#endif
+}
+
+#endif //DUAL_SENSE_HID_TRANSPORT_HPP
@@ -0,0 +1,126 @@
+#ifndef DUAL_SENSE_HID_TRIPLE_BUFFER_HPP
+#define DUAL_SENSE_HID_TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "spsc_ring.hpp"
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief Lock-free single-producer/single-consumer mailbox holding only latest value
+	 *
+	 * Producer writes into its private buffer and publishes it by swapping with shared one,
+	 * so it never waits for consumer. Values published before consumer took them are overwritten.
+	 * @note Producer methods may be called only from one thread and consumer methods only from one (other) thread
+	 */
+	template<typename T>
+	class TripleBuffer
+	{
+	public:
+		/**
+		 * @brief Producer: buffer to fill before publish
+		 */
+		T& back()
+		{
+			return buffers_[back_];
+		}
+
+		/**
+		 * @brief Producer: make back buffer latest value
+		 */
+		void publish()
+		{
+			back_ = swap(static_cast<uint8_t>(back_ | FRESH));
+			shared_.notify_one();
+		}
+
+		/**
+		 * @brief Producer: check if previously published value wasn't taken yet
+		 */
+		[[nodiscard]] bool pending() const
+		{
+			return (shared_.load(std::memory_order_acquire) & FRESH) != 0;
+		}
+
+		/**
+		 * @brief Wake consumer and make wait_take return once no value is pending
+		 */
+		void close()
+		{
+			shared_.fetch_or(CLOSED, std::memory_order_acq_rel);
+			shared_.notify_one();
+		}
+
+		/**
+		 * @brief Consumer: take latest value if there is new one
+		 * @return Value valid until next take or nullptr
+		 */
+		const T* try_take()
+		{
+			if((shared_.load(std::memory_order_relaxed) & FRESH) == 0)
+			{
+				return nullptr;
+			}
+
+			front_ = swap(front_);
+
+			return &buffers_[front_];
+		}
+
+		/**
+		 * @brief Consumer: wait for new value
+		 * @return Value valid until next take or nullptr if mailbox was closed
+		 */
+		const T* wait_take()
+		{
+			auto shared = shared_.load(std::memory_order_acquire);
+			while((shared & FRESH) == 0)
+			{
+				if((shared & CLOSED) != 0)
+				{
+					return nullptr;
+				}
+
+				shared_.wait(shared, std::memory_order_acquire);
+				shared = shared_.load(std::memory_order_acquire);
+			}
+
+			return try_take();
+		}
+
+	private:
+		static constexpr uint8_t INDEX_MASK = 0b0011;
+		static constexpr uint8_t FRESH = 0b0100;
+		static constexpr uint8_t CLOSED = 0b1000;
+
+		std::array<T, 3> buffers_{};
+
+		alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> shared_ = 1;
+		alignas(CACHE_LINE_SIZE) uint8_t back_ = 0;
+		alignas(CACHE_LINE_SIZE) uint8_t front_ = 2;
+
+		/**
+		 * @brief Put buffer into shared slot, keeping CLOSED bit which may be set concurrently
+		 * @return Index of buffer previously in shared slot
+		 */
+		uint8_t swap(uint8_t value)
+		{
+			auto shared = shared_.load(std::memory_order_relaxed);
+			while(!shared_.compare_exchange_weak(
+					shared,
+					static_cast<uint8_t>(value | (shared & CLOSED)),
+					std::memory_order_acq_rel,
+					std::memory_order_relaxed
+			))
+			{}
+
+			return static_cast<uint8_t>(shared & INDEX_MASK);
+		}
+	};
+}
+
+#endif //DUAL_SENSE_HID_TRIPLE_BUFFER_HPP
@@ -0,0 +1,32 @@
+#ifndef DUAL_SENSE_HID_DETAIL_UEVENT_HPP
+#define DUAL_SENSE_HID_DETAIL_UEVENT_HPP
+
+#include <optional>
+#include <span>
+#include <string_view>
+
+
+namespace dual_sense_hid::detail
+{
+	/**
+	 * @brief Fields of device uevent relevant for hotplug. Views point into parsed message
+	 */
+	struct Uevent
+	{
+		std::string_view action; /*!< e.g. add, remove, change */
+		std::string_view subsystem; /*!< e.g. hidraw */
+		std::string_view devname; /*!< Node name without /dev/ prefix (may be empty) */
+	};
+
+	/**
+	 * @brief Parse netlink uevent message
+	 *
+	 * Accepts both kernel messages ("action@devpath" followed by KEY=VALUE list)
+	 * and messages rebroadcast by udev (with "libudev" header).
+	 * @param message Received datagram
+	 * @return Parsed fields or empty optional if message is malformed
+	 */
+	std::optional<Uevent> parse_uevent(std::span<const char> message);
+}
+
+#endif //DUAL_SENSE_HID_DETAIL_UEVENT_HPP
@@ -23,6 +23,11 @@ namespace dual_sense_hid
 		 * @brief Type of connection
 		 */
 		ConnectionType connection_type;
+
+		/**
+		 * @brief Backend device path belongs to
+		 */
+		Backend backend = Backend::HIDAPI;
 	};
 }
 
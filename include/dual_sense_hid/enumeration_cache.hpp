@@ -0,0 +1,52 @@
+#ifndef DUAL_SENSE_HID_ENUMERATION_CACHE_HPP
+#define DUAL_SENSE_HID_ENUMERATION_CACHE_HPP
+
+#include <span>
+#include <vector>
+
+#include "device_info.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Incremental hidapi enumeration reporting only changes since previous scan
+	 *
+	 * Already known gamepads are matched by path without converting their strings,
+	 * so rescans with unchanged set of gamepads don't allocate beyond hidapi itself.
+	 */
+	class EnumerationCache
+	{
+	public:
+		/**
+		 * @brief Difference between two scans. Spans are valid until next rescan
+		 */
+		struct Changes
+		{
+			std::span<const DeviceInfo> added; /*!< Gamepads connected since previous scan */
+			std::span<const DeviceInfo> removed; /*!< Gamepads disconnected since previous scan */
+		};
+
+		/**
+		 * @brief Enumerate gamepads and compare with previous scan
+		 *
+		 * First scan reports every connected gamepad as added.
+		 * @return Added and removed gamepads
+		 */
+		Changes rescan();
+
+		/**
+		 * @brief Gamepads connected during last scan
+		 * @return Info of connected gamepads
+		 */
+		[[nodiscard]] const std::vector<DeviceInfo>& devices() const;
+
+	private:
+		std::vector<DeviceInfo> devices_;
+		std::vector<DeviceInfo> added_;
+		std::vector<DeviceInfo> removed_;
+		std::vector<bool> seen_;
+	};
+}
+
+#endif //DUAL_SENSE_HID_ENUMERATION_CACHE_HPP
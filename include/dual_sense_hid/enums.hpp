@@ -15,6 +15,64 @@ namespace dual_sense_hid
 		USB, /*!< USB connection */
 		BLUETOOTH /*!< Bluetooth connection */
 	};
+
+	/**
+	 * @enum Backend
+	 * @brief I/O backend used to talk to device
+	 */
+	enum class Backend: uint8_t
+	{
+		HIDAPI, /*!< hidapi library */
+		HIDRAW  /*!< Native Linux hidraw node */
+	};
+
+	/**
+	 * @enum Button
+	 * @brief Gamepad button. Value is index of button bit in button mask
+	 * @see CompactState
+	 */
+	enum class Button: uint8_t
+	{
+		DPAD_UP     = 0, /*!< North DigitalPad button */
+		DPAD_RIGHT  = 1, /*!< East DigitalPad button */
+		DPAD_DOWN   = 2, /*!< South DigitalPad button */
+		DPAD_LEFT   = 3, /*!< West DigitalPad button */
+		SQUARE      = 4, /*!< Square button */
+		CROSS       = 5, /*!< Cross button */
+		CIRCLE      = 6, /*!< Circle button */
+		TRIANGLE    = 7, /*!< Triangle button */
+		L1          = 8, /*!< Left bumper */
+		R1          = 9, /*!< Right bumper */
+		L2          = 10, /*!< Left trigger as button */
+		R2          = 11, /*!< Right trigger as button */
+		CREATE      = 12, /*!< Create button */
+		MENU        = 13, /*!< Menu button */
+		L3          = 14, /*!< Left analog button */
+		R3          = 15, /*!< Right analog button */
+		HOME        = 16, /*!< Home button */
+		TOUCHPAD    = 17, /*!< Touchpad button */
+		MUTE        = 18  /*!< Mute button */
+	};
+
+	/**
+	 * @brief Number of buttons represented in button mask
+	 */
+	static constexpr uint8_t BUTTON_COUNT = 19;
+
+	/**
+	 * @brief Mask with bits of all buttons set
+	 */
+	static constexpr uint32_t ALL_BUTTONS = (1u << BUTTON_COUNT) - 1;
+
+	/**
+	 * @brief Get bit mask of button
+	 * @param button Button
+	 * @return Mask with bit of button set
+	 */
+	constexpr uint32_t button_mask(Button button)
+	{
+		return 1u << static_cast<uint8_t>(button);
+	}
 }
 
 #endif //DUAL_SENSE_HID_ENUMS_HPP
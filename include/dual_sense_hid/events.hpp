@@ -0,0 +1,98 @@
+#ifndef DUAL_SENSE_HID_EVENTS_HPP
+#define DUAL_SENSE_HID_EVENTS_HPP
+
+#include <cstdint>
+#include <functional>
+
+#include "enums.hpp"
+#include "state.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Change of gamepad state reported to subscribers
+	 * @see Gamepad::subscribe
+	 */
+	struct Event
+	{
+		/**
+		 * @enum Type
+		 * @brief Type of change
+		 */
+		enum class Type: uint8_t
+		{
+			BUTTON_PRESSED          = 0, /*!< Buttons went down */
+			BUTTON_RELEASED         = 1, /*!< Buttons went up */
+			LEFT_STICK_MOVED        = 2, /*!< Left stick moved by at least stick threshold */
+			RIGHT_STICK_MOVED       = 3, /*!< Right stick moved by at least stick threshold */
+			LEFT_TRIGGER_CHANGED    = 4, /*!< Left trigger moved by at least trigger threshold */
+			RIGHT_TRIGGER_CHANGED   = 5, /*!< Right trigger moved by at least trigger threshold */
+			TOUCH_BEGIN             = 6, /*!< Touch point became active */
+			TOUCH_END               = 7, /*!< Touch point became inactive */
+			BATTERY_CHANGED         = 8, /*!< Battery level or power status changed */
+
+			LAST = BATTERY_CHANGED /*!< Last event type, must follow newly added types */
+		};
+
+		Type type; /*!< Type of change */
+		uint32_t buttons; /*!< Mask of changed buttons for button events, otherwise 0 */
+		uint8_t touch_point; /*!< Index of touch point for touch events, otherwise 0 */
+	};
+
+	/**
+	 * @brief Get bit mask of event type
+	 * @param type Event type
+	 * @return Mask with bit of event type set
+	 */
+	constexpr uint32_t event_mask(Event::Type type)
+	{
+		return 1u << static_cast<uint8_t>(type);
+	}
+
+	/**
+	 * @brief Mask with bits of all event types set
+	 */
+	static constexpr uint32_t ALL_EVENTS = (event_mask(Event::Type::LAST) << 1) - 1;
+
+	/**
+	 * @brief Filter applied before subscription callback is called
+	 */
+	struct EventFilter
+	{
+		uint32_t events = ALL_EVENTS; /*!< Mask of event types to report */
+		uint32_t buttons = ALL_BUTTONS; /*!< Mask of buttons to report edges of */
+		uint8_t stick_threshold = 8; /*!< Minimal stick movement on any axis since last reported position */
+		uint8_t trigger_threshold = 4; /*!< Minimal trigger movement since last reported position */
+	};
+
+	/**
+	 * @brief Subscription callback. Receives event and state of report which caused it
+	 */
+	using EventCallback = std::function<void(const Event&, const State&)>;
+
+	/**
+	 * @brief Identifier of subscription
+	 */
+	using SubscriptionId = uint32_t;
+
+	namespace detail
+	{
+		struct Subscription
+		{
+			SubscriptionId id;
+			EventFilter filter;
+			EventCallback callback;
+
+			bool initialized = false;
+			State::AnalogPad left_pad{};
+			State::AnalogPad right_pad{};
+			uint8_t left_trigger = 0;
+			uint8_t right_trigger = 0;
+
+			void dispatch(const State& previous, const State& current, uint32_t pressed, uint32_t released);
+		};
+	}
+}
+
+#endif //DUAL_SENSE_HID_EVENTS_HPP
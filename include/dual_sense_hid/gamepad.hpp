@@ -3,22 +3,46 @@
 
 #include <vector>
 #include <string>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
 
 #include "device_info.hpp"
 #include "state.hpp"
 #include "enums.hpp"
 #include "calibration.hpp"
+#include "calibration_cache.hpp"
+#include "raw_report.hpp"
+#include "input_edges.hpp"
+#include "events.hpp"
+#include "gyro_bias.hpp"
+#include "orientation.hpp"
+#include "awaitable.hpp"
+#include "detail/calibration_kernel.hpp"
+#include "detail/seqlock.hpp"
+#include "detail/spsc_ring.hpp"
+#include "detail/timestamp.hpp"
+#include "detail/triple_buffer.hpp"
 
 
-struct hid_device_;
-typedef struct hid_device_ hid_device;
-
 /**
  * @namespace dual_sense_hid
  * @brief Dual Sense support library
  */
 namespace dual_sense_hid
 {
+	namespace detail
+	{
+		struct ReportCommon;
+		struct SetStateReportCommon;
+		class Transport;
+	}
+
 	static constexpr unsigned long VENDOR_ID = 1356ul; /*!< Vendor ID of DualSense gamepad */
 	static constexpr unsigned long PRODUCT_ID = 3302ul; /*!< Product ID of DualSense gamepad */
 
@@ -34,6 +58,11 @@ namespace dual_sense_hid
 	class Gamepad
 	{
 	public:
+		/**
+		 * @brief Maximum number of decoded states buffered by reader thread
+		 */
+		static constexpr std::size_t READER_QUEUE_CAPACITY = 256;
+
 		/**
 		 * @brief Proxy object for calls which mutate state of gamepad's lights
 		 */
@@ -111,17 +140,31 @@ namespace dual_sense_hid
 			void set_touchpad_light_color(uint8_t red, uint8_t green, uint8_t blue);
 
 		private:
-			MuteLightMode mute_light_mode_;
+			/**
+			 * @brief Output report sections changed since last push (bit mask)
+			 */
+			enum Section: uint8_t
+			{
+				LED_COLOR_SECTION           = 1u << 0,
+				PLAYER_INDICATORS_SECTION   = 1u << 1,
+				BRIGHTNESS_SECTION          = 1u << 2,
+				MUTE_LIGHT_SECTION          = 1u << 3,
+				COLOR_FADE_SECTION          = 1u << 4, /*!< Sent only with full update */
 
-			PlayerIndicator player_indicator_;
-			bool player_indicator_fade_enabled_;
-			PlayerIndicatorBrightness player_indicator_brightness_;
+				ALL_SECTIONS = LED_COLOR_SECTION | PLAYER_INDICATORS_SECTION | BRIGHTNESS_SECTION | MUTE_LIGHT_SECTION
+			};
+
+			MuteLightMode mute_light_mode_ = MuteLightMode::OFF;
 
-			uint8_t touchpad_light_red_;
-			uint8_t touchpad_light_green_;
-			uint8_t touchpad_light_blue_;
+			PlayerIndicator player_indicator_ = PlayerIndicator::DISABLED;
+			bool player_indicator_fade_enabled_ = false;
+			PlayerIndicatorBrightness player_indicator_brightness_ = PlayerIndicatorBrightness::MAX;
 
-			bool changed_ = true;
+			uint8_t touchpad_light_red_ = 0;
+			uint8_t touchpad_light_green_ = 0;
+			uint8_t touchpad_light_blue_ = 0;
+
+			uint8_t dirty_ = ALL_SECTIONS;
 
 			friend class Gamepad;
 		};
@@ -133,6 +176,24 @@ namespace dual_sense_hid
 		 */
 		explicit Gamepad(const DeviceInfo& device_info, bool fetch_calibration_data=true);
 
+		/**
+		 * @brief Constructor taking calibration data from cache
+		 *
+		 * Calibration data is fetched from device (and stored in cache) only when cache has no valid entry
+		 * for serial of device.
+		 * @param device_info Device info to create gamepad instance for
+		 * @param calibration_cache Cache of calibration data
+		 */
+		Gamepad(const DeviceInfo& device_info, const CalibrationCache& calibration_cache);
+
+		Gamepad(const Gamepad&) = delete;
+		Gamepad& operator=(const Gamepad&) = delete;
+
+		/**
+		 * @brief Destructor. Stops reader thread and closes device
+		 */
+		~Gamepad();
+
 		/**
 		 * @brief Poll state of gamepad from report queue
 		 * @param use_calibration_data Apply accelerometer & gyroscope calibration data to readings
@@ -140,11 +201,215 @@ namespace dual_sense_hid
 		 */
 		[[nodiscard]] State poll(bool use_calibration_data=true) const;
 
+		/**
+		 * @brief Poll state of gamepad from report queue without blocking
+		 * @param use_calibration_data Apply accelerometer & gyroscope calibration data to readings
+		 * @return A state of gamepad or empty optional if no report is queued
+		 */
+		[[nodiscard]] std::optional<State> try_poll(bool use_calibration_data=true) const;
+
+		/**
+		 * @brief Poll state of gamepad from report queue, waiting at most given time for a report
+		 * @param timeout Maximum time to wait for a report (rounded up to milliseconds)
+		 * @param use_calibration_data Apply accelerometer & gyroscope calibration data to readings
+		 * @return A state of gamepad or empty optional if no report arrived before timeout
+		 */
+		[[nodiscard]] std::optional<State> poll_for(std::chrono::microseconds timeout, bool use_calibration_data=true) const;
+
+		/**
+		 * @brief Drain report queue without blocking and decode only the newest report
+		 * @note Older queued reports are discarded without being decoded
+		 * @param use_calibration_data Apply accelerometer & gyroscope calibration data to readings
+		 * @return A state from the newest queued report or empty optional if no report is queued
+		 */
+		[[nodiscard]] std::optional<State> poll_latest(bool use_calibration_data=true) const;
+
+		/**
+		 * @brief Drain report queue without blocking, decoding every queued report
+		 * @param out Buffer for decoded states. At most out.size() reports are read
+		 * @param use_calibration_data Apply accelerometer & gyroscope calibration data to readings
+		 * @return Number of states written to the beginning of out
+		 */
+		std::size_t poll_batch(std::span<State> out, bool use_calibration_data=true) const;
+
+		/**
+		 * @brief Read next report without decoding it, blocking until report arrives
+		 * @param report Report buffer read directly into
+		 */
+		void poll_raw(RawReport& report) const;
+
+		/**
+		 * @brief Read next report without decoding it and without blocking
+		 * @param report Report buffer read directly into
+		 * @return true if report was read, false if no report is queued
+		 */
+		bool try_poll_raw(RawReport& report) const;
+
+		/**
+		 * @brief Decode raw report into state
+		 * @param report Raw report read from this gamepad
+		 * @param use_calibration_data Apply accelerometer & gyroscope calibration data to readings
+		 * @return A state decoded from report
+		 * @note Sensor timestamp is extended relatively to previously decoded report, so reports should be
+		 * decoded in order they were read
+		 */
+		[[nodiscard]] State decode(const RawReport& report, bool use_calibration_data=true) const;
+
+		/**
+		 * @brief Start background thread which reads and decodes every report into internal queue
+		 * @note Poll methods can't be used while reader thread is running
+		 * @note Exceptions thrown by subscribers or coroutines resumed on reader thread are discarded, reader keeps running
+		 * @param use_calibration_data Apply accelerometer & gyroscope calibration data to readings
+		 */
+		void start_reader(bool use_calibration_data=true);
+
+		/**
+		 * @brief Stop background reader thread. States already queued can still be popped
+		 */
+		void stop_reader();
+
+		/**
+		 * @brief Check if background reader thread is reading reports
+		 * @return false if reader was not started, was stopped or failed to read from device
+		 */
+		[[nodiscard]] bool is_reader_running() const;
+
+		/**
+		 * @brief Pop oldest state decoded by reader thread
+		 * @note Lock-free. Must be called from single consumer thread
+		 * @return Oldest queued state or empty optional if queue is empty
+		 */
+		[[nodiscard]] std::optional<State> pop_state();
+
+		/**
+		 * @brief Get number of reports dropped by reader thread because queue was full
+		 * @return Number of dropped reports
+		 */
+		[[nodiscard]] std::size_t dropped_reports() const;
+
+		/**
+		 * @brief Get snapshot of most recently decoded state without consuming any queue
+		 * @note Thread-safe. Fed by reader thread or by poll calls
+		 * @return Latest state or empty optional if no report was decoded yet
+		 */
+		[[nodiscard]] std::optional<State> latest_state() const;
+
+		/**
+		 * @brief Get button edges tracker updated with every decoded report
+		 * @note Updated by thread decoding reports. When reader thread is running, use it only from that thread
+		 * @return Button edges tracker
+		 */
+		[[nodiscard]] const InputEdges& edges() const;
+
+		/**
+		 * @brief Enable online tracking of residual gyroscope bias
+		 * @param config Stillness detection settings
+		 * @note Estimated bias is subtracted from gyroscope readings of reports decoded with calibration data.
+		 * Can't be called while reader thread is running
+		 */
+		void enable_gyro_bias_tracking(const GyroBiasConfig& config = {});
+
+		/**
+		 * @brief Disable online tracking of gyroscope bias
+		 * @note Can't be called while reader thread is running
+		 */
+		void disable_gyro_bias_tracking();
+
+		/**
+		 * @brief Get current gyroscope bias estimation. Safe to call from any thread
+		 * @return Bias estimation or std::nullopt if tracking is disabled
+		 */
+		[[nodiscard]] std::optional<GyroBias> gyro_bias() const;
+
+		/**
+		 * @brief Enable orientation tracking with MadgwickFilter
+		 * @param beta Gain of accelerometer correction
+		 * @note Only reports decoded with calibration data update orientation.
+		 * Can't be called while reader thread is running
+		 */
+		void enable_orientation(float beta = MadgwickFilter::DEFAULT_BETA);
+
+		/**
+		 * @brief Disable orientation tracking
+		 * @note Can't be called while reader thread is running
+		 */
+		void disable_orientation();
+
+		/**
+		 * @brief Get orientation fused from decoded reports. Safe to call from any thread
+		 * @return Orientation or std::nullopt if tracking is disabled
+		 */
+		[[nodiscard]] std::optional<Quaternion> orientation() const;
+
+		/**
+		 * @brief Subscribe to changes of gamepad state
+		 *
+		 * Callback is called from thread decoding reports (reader thread when started), only for events
+		 * which pass filter. Callback must not subscribe or unsubscribe. Exception thrown by callback doesn't
+		 * stop other subscribers; first one is rethrown from poll method which decoded report, or discarded
+		 * on reader thread.
+		 * @param callback Function called for every matching event
+		 * @param filter Event types, buttons and movement thresholds to report
+		 * @return Identifier of subscription
+		 * @see start_reader
+		 */
+		SubscriptionId subscribe(EventCallback callback, const EventFilter& filter = {});
+
+		/**
+		 * @brief Remove subscription
+		 * @param id Identifier returned by subscribe
+		 */
+		void unsubscribe(SubscriptionId id);
+
+		/**
+		 * @brief Get awaitable resumed with state of next decoded report
+		 * @note Coroutine is resumed from thread decoding reports (reader thread when started) via executor.
+		 * Gamepad must outlive all suspended coroutines.
+		 * @param executor Executor resuming coroutine (default: resume inline)
+		 * @return Awaitable yielding next state
+		 */
+		[[nodiscard]] StateAwaitable next_state(Executor executor = {});
+
+		/**
+		 * @brief Get awaitable resumed with state of next report in which any of given buttons changed
+		 * @note Coroutine is resumed from thread decoding reports (reader thread when started) via executor.
+		 * Gamepad must outlive all suspended coroutines.
+		 * @param buttons Mask of buttons to wait for press or release of
+		 * @param executor Executor resuming coroutine (default: resume inline)
+		 * @return Awaitable yielding state of report with change
+		 */
+		[[nodiscard]] StateAwaitable next_change(uint32_t buttons = ALL_BUTTONS, Executor executor = {});
+
 		/**
 		 * @brief Push internal gamepad state to real device
+		 *
+		 * Only sections changed since last successful push are enabled in report.
+		 * If nothing changed, no report is written at all.
+		 * With async output running, report is only handed over to writer thread and call never blocks.
 		 * @param full_update When set to false push only changed sections, otherwise push everything
+		 * @return true if report was written (or queued for writer thread)
 		 */
-		void push_state(bool full_update = false);
+		bool push_state(bool full_update = false);
+
+		/**
+		 * @brief Start background thread writing output reports
+		 *
+		 * push_state then only publishes snapshot of output state. Writer sends latest snapshot,
+		 * snapshots superseded before being sent are dropped (their changes are merged into newer one).
+		 * @note Write errors aren't reported in this mode
+		 */
+		void start_async_output();
+
+		/**
+		 * @brief Stop background writer thread. Last published snapshot is written before stopping
+		 */
+		void stop_async_output();
+
+		/**
+		 * @brief Check if background writer thread is running
+		 * @return true if async output was started
+		 */
+		[[nodiscard]] bool is_async_output_running() const;
 
 		/**
 		 * @brief Get calibration data (cached)
@@ -152,6 +417,19 @@ namespace dual_sense_hid
 		 */
 		const Calibration& get_calibration_data() const;
 
+		/**
+		 * @brief Get pollable file descriptor of device
+		 * @note Available only for Backend::HIDRAW devices
+		 * @return File descriptor or -1 if backend doesn't expose it
+		 */
+		[[nodiscard]] int native_handle() const;
+
+		/**
+		 * @brief Get type of connection with device
+		 * @return Connection type
+		 */
+		[[nodiscard]] ConnectionType connection_type() const;
+
 		/**
 		 * @brief Get gamepad's lights proxy object
 		 * @return Gamepad's lights proxy object
@@ -159,16 +437,89 @@ namespace dual_sense_hid
 		[[nodiscard]] Lights& lights();
 
 	private:
-		hid_device* device_;
+		std::unique_ptr<detail::Transport> transport_;
 		ConnectionType connection_type_;
 
 		mutable bool calibration_data_loaded_ = false;
 		mutable Calibration calibration_data_;
+		mutable detail::CalibrationKernel calibration_kernel_;
 
 		Lights lights_;
 
+		std::unique_ptr<detail::SpscRing<State, READER_QUEUE_CAPACITY>> reader_queue_;
+		std::atomic<std::size_t> dropped_reports_ = 0;
+		std::atomic<bool> reader_running_ = false;
+		std::jthread reader_thread_;
+
+		std::unique_ptr<detail::TripleBuffer<detail::SetStateReportCommon>> output_mailbox_;
+		uint8_t unsent_sections_ = 0;
+		std::jthread writer_thread_;
+
+		mutable detail::Seqlock<State> latest_state_;
+		mutable InputEdges edges_;
+		mutable detail::TimestampExtender sensor_clock_;
+
+		mutable std::optional<GyroBiasEstimator> gyro_bias_estimator_;
+		mutable detail::Seqlock<GyroBias> gyro_bias_;
+
+		mutable std::optional<MadgwickFilter> orientation_filter_;
+		mutable detail::Seqlock<Quaternion> orientation_;
+
+		mutable std::mutex listeners_mutex_;
+		mutable std::atomic<std::size_t> listener_count_ = 0;
+		mutable std::vector<detail::Subscription> subscriptions_;
+		SubscriptionId next_subscription_id_ = 1;
+		mutable std::optional<State> previous_state_;
+
+		mutable std::vector<detail::StateWaiter> waiters_;
+
+		void add_waiter(detail::StateWaiter waiter);
+
+		friend class StateAwaitable;
+		friend class GamepadHub;
+		friend class UringReader;
+
+		void ensure_reader_stopped() const;
+		void reader_loop(const std::stop_token& stop_token, bool use_calibration_data);
+		void writer_loop(const std::stop_token& stop_token);
+
+		bool read_report(uint8_t* report, int timeout_ms) const;
+		State process_report(const detail::ReportCommon& common, bool use_calibration_data) const;
+		State process_report(const detail::ReportCommon& common, bool use_calibration_data, std::exception_ptr& listener_error) const;
+		State process_raw_report(const uint8_t* report, bool use_calibration_data) const;
+		State decode_report(const detail::ReportCommon& common, bool use_calibration_data, uint64_t host_timestamp) const;
+
+		detail::SetStateReportCommon build_output_report(uint8_t sections) const;
 		void take_lights_control();
+		void set_calibration_data(const Calibration& calibration) const;
+	};
+
+	/**
+	 * @brief Result of opening single device with open_all
+	 */
+	struct OpenResult
+	{
+		std::unique_ptr<Gamepad> gamepad; /*!< Opened gamepad or nullptr if opening failed */
+		std::exception_ptr error; /*!< Reason of failure if gamepad is nullptr */
 	};
+
+	/**
+	 * @brief Open and initialize gamepads concurrently
+	 *
+	 * Total time is bounded by the slowest gamepad instead of sum of all of them.
+	 * @param devices Devices to open
+	 * @param fetch_calibration_data Prefetch calibration data while initializing (default: true)
+	 * @return Results in order of devices
+	 */
+	std::vector<OpenResult> open_all(std::span<const DeviceInfo> devices, bool fetch_calibration_data=true);
+
+	/**
+	 * @brief Open and initialize gamepads concurrently, taking calibration data from cache
+	 * @param devices Devices to open
+	 * @param calibration_cache Cache of calibration data
+	 * @return Results in order of devices
+	 */
+	std::vector<OpenResult> open_all(std::span<const DeviceInfo> devices, const CalibrationCache& calibration_cache);
 }
 
 #endif //DUAL_SENSE_HID_GAMEPAD_HPP
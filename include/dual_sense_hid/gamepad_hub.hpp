@@ -0,0 +1,99 @@
+#ifndef DUAL_SENSE_HID_GAMEPAD_HUB_HPP
+#define DUAL_SENSE_HID_GAMEPAD_HUB_HPP
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <vector>
+
+#include <sys/epoll.h>
+
+#include "gamepad.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Single-threaded epoll reactor reading many gamepads
+	 *
+	 * Only gamepads opened with Backend::HIDRAW can be added. Every report goes through the same
+	 * processing as Gamepad::try_poll (edges, subscriptions, latest state), then is passed to callback.
+	 */
+	class GamepadHub
+	{
+	public:
+		/**
+		 * @brief Callback receiving decoded state of gamepad
+		 */
+		using Callback = std::function<void(Gamepad&, const State&)>;
+
+		/**
+		 * @brief Callback called when gamepad fails and is removed from hub
+		 */
+		using DisconnectCallback = std::function<void(Gamepad&)>;
+
+		/**
+		 * @brief Constructor
+		 * @param callback Function called with every decoded state
+		 * @param disconnect_callback Function called when gamepad fails to read (optional)
+		 */
+		explicit GamepadHub(Callback callback, DisconnectCallback disconnect_callback = {});
+
+		GamepadHub(const GamepadHub&) = delete;
+		GamepadHub& operator=(const GamepadHub&) = delete;
+
+		~GamepadHub();
+
+		/**
+		 * @brief Add gamepad to hub. Gamepad must outlive its membership in hub
+		 * @param gamepad Gamepad opened with Backend::HIDRAW, without running reader thread
+		 * @param use_calibration_data Apply accelerometer & gyroscope calibration data to readings
+		 */
+		void add(Gamepad& gamepad, bool use_calibration_data = true);
+
+		/**
+		 * @brief Remove gamepad from hub
+		 * @note Must not be called from hub callbacks
+		 * @param gamepad Gamepad previously added
+		 */
+		void remove(Gamepad& gamepad);
+
+		/**
+		 * @brief Wait for reports and dispatch one report of every ready gamepad
+		 * @note Exceptions thrown by callback or gamepad subscribers are propagated without removing gamepad,
+		 * remaining ready gamepads are dispatched in next call
+		 * @param timeout Maximum wait time (negative - wait indefinitely)
+		 * @return Number of dispatched states
+		 */
+		std::size_t run_once(std::chrono::milliseconds timeout);
+
+		/**
+		 * @brief Dispatch reports until stop is requested
+		 * @param stop_token Token stopping loop
+		 */
+		void run(const std::stop_token& stop_token);
+
+	private:
+		struct Entry
+		{
+			Gamepad* gamepad;
+			bool use_calibration_data;
+		};
+
+		static constexpr std::size_t MAX_EVENTS = 16;
+
+		int epoll_fd_;
+		Callback callback_;
+		DisconnectCallback disconnect_callback_;
+
+		std::vector<std::unique_ptr<Entry>> entries_;
+		std::array<epoll_event, MAX_EVENTS> events_{};
+
+		void drop(Entry& entry);
+		void drop_all(const std::vector<Entry*>& entries);
+	};
+}
+
+#endif //DUAL_SENSE_HID_GAMEPAD_HUB_HPP
@@ -0,0 +1,97 @@
+#ifndef DUAL_SENSE_HID_GYRO_BIAS_HPP
+#define DUAL_SENSE_HID_GYRO_BIAS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "calibration.hpp"
+#include "state.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Current result of gyroscope bias tracking
+	 */
+	struct GyroBias
+	{
+		State::Gyro bias; /*!< Estimated bias in calibrated units */
+		bool still; /*!< true if gamepad is considered still in current window */
+	};
+
+	/**
+	 * @brief Stillness detection settings (calibrated units)
+	 */
+	struct GyroBiasConfig
+	{
+		/** Maximal standard deviation of gyroscope axis (default: 1 deg/s) */
+		int32_t gyro_threshold = Calibration::GYROSCOPE_RESOLUTION;
+		/** Maximal standard deviation of accelerometer axis (default: ~0.02 g) */
+		int32_t acceleration_threshold = Calibration::ACCELEROMETER_RESOLUTION / 50;
+		/** Window mean above this rate is treated as slow rotation instead of bias (default: 5 deg/s) */
+		int32_t max_bias = 5 * Calibration::GYROSCOPE_RESOLUTION;
+	};
+
+	/**
+	 * @brief Online estimator of residual gyroscope bias
+	 *
+	 * Keeps running sums over sliding window of calibrated samples. When variance of every
+	 * gyroscope and accelerometer axis is below threshold, gamepad is considered still
+	 * and window mean of gyroscope becomes new bias. Each update costs O(1) and never allocates.
+	 */
+	class GyroBiasEstimator
+	{
+	public:
+		/**
+		 * @brief Number of samples in sliding window
+		 */
+		static constexpr size_t WINDOW_SIZE = 256;
+
+		/**
+		 * @brief Create estimator with zero initial bias
+		 * @param config Stillness detection settings
+		 */
+		explicit GyroBiasEstimator(const GyroBiasConfig& config = {});
+
+		/**
+		 * @brief Feed estimator with next sample
+		 * @param gyro Calibrated gyroscope reading (without bias correction)
+		 * @param acceleration Calibrated accelerometer reading
+		 */
+		void update(const State::Gyro& gyro, const State::Acceleration& acceleration);
+
+		/**
+		 * @brief Subtract estimated bias from gyroscope reading
+		 * @param gyro Gyroscope reading to correct in place
+		 */
+		void correct(State::Gyro& gyro) const;
+
+		/**
+		 * @brief Get estimated bias and stillness flag
+		 * @return Current estimation
+		 */
+		[[nodiscard]] GyroBias bias() const;
+
+		/**
+		 * @brief Forget window and estimated bias
+		 */
+		void reset();
+
+	private:
+		static constexpr size_t AXES = 6;
+
+		GyroBiasConfig config_;
+
+		std::array<std::array<int32_t, AXES>, WINDOW_SIZE> window_{};
+		size_t next_ = 0;
+		size_t count_ = 0;
+
+		std::array<int64_t, AXES> sums_{};
+		std::array<int64_t, AXES> squares_{};
+
+		GyroBias bias_{};
+	};
+}
+
+#endif //DUAL_SENSE_HID_GYRO_BIAS_HPP
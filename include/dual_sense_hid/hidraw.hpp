@@ -0,0 +1,25 @@
+#ifndef DUAL_SENSE_HID_HIDRAW_HPP
+#define DUAL_SENSE_HID_HIDRAW_HPP
+
+#include <vector>
+
+#include "device_info.hpp"
+
+
+/**
+ * @namespace dual_sense_hid::hidraw
+ * @brief Native Linux hidraw backend
+ *
+ * Devices enumerated here are opened directly through /dev/hidrawN, without hidapi.
+ * Their file descriptor is available through Gamepad::native_handle.
+ */
+namespace dual_sense_hid::hidraw
+{
+	/**
+	 * @brief Enumerate connected gamepads via sysfs
+	 * \return A vector of info for connected devices with Backend::HIDRAW
+	 */
+	std::vector<DeviceInfo> enumerate();
+}
+
+#endif //DUAL_SENSE_HID_HIDRAW_HPP
@@ -0,0 +1,104 @@
+#ifndef DUAL_SENSE_HID_HOTPLUG_MONITOR_HPP
+#define DUAL_SENSE_HID_HOTPLUG_MONITOR_HPP
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include "device_info.hpp"
+
+
+namespace dual_sense_hid
+{
+	namespace detail
+	{
+		struct Uevent;
+	}
+
+	/**
+	 * @brief Connection or disconnection of gamepad
+	 */
+	struct HotplugEvent
+	{
+		/**
+		 * @brief Kind of change
+		 */
+		enum class Action
+		{
+			ADDED,
+			REMOVED
+		};
+
+		Action action; /*!< Kind of change */
+		DeviceInfo device_info; /*!< Gamepad info (Backend::HIDRAW) */
+	};
+
+	/**
+	 * @brief Event-driven discovery of gamepads through netlink uevent socket
+	 *
+	 * Listens for hidraw nodes being added or removed, so no periodic enumeration is needed.
+	 * Only DualSense gamepads are reported. If kernel drops messages because they weren't
+	 * received in time, sysfs is rescanned and missed changes are reported as regular events.
+	 */
+	class HotplugMonitor
+	{
+	public:
+		/**
+		 * @brief Origin of uevents
+		 */
+		enum class Source
+		{
+			/** Kernel broadcast. Works without udev, but /dev node permissions may not be applied yet */
+			KERNEL,
+			/** Rebroadcast by udev after its rules were processed. Requires running udev daemon */
+			UDEV
+		};
+
+		/**
+		 * @brief Open uevent socket and take initial snapshot of connected gamepads
+		 * @param source Origin of uevents
+		 */
+		explicit HotplugMonitor(Source source = Source::KERNEL);
+
+		HotplugMonitor(const HotplugMonitor&) = delete;
+		HotplugMonitor& operator=(const HotplugMonitor&) = delete;
+
+		~HotplugMonitor();
+
+		/**
+		 * @brief Wait for uevents and translate pending ones
+		 * @param timeout Maximum wait time (negative - wait indefinitely, zero - don't wait)
+		 * @return Events in order of arrival (empty if timed out)
+		 */
+		std::vector<HotplugEvent> poll(std::chrono::milliseconds timeout);
+
+		/**
+		 * @brief Currently connected gamepads, as known after last poll
+		 * @return Info of connected gamepads
+		 */
+		[[nodiscard]] const std::vector<DeviceInfo>& devices() const;
+
+		/**
+		 * @brief Get non-blocking socket to wait on in external event loop
+		 *
+		 * When it becomes readable, call poll with zero timeout.
+		 * @return Socket file descriptor
+		 */
+		[[nodiscard]] int native_handle() const;
+
+	private:
+		static constexpr size_t BUFFER_SIZE = 8192;
+
+		int socket_;
+		Source source_;
+
+		std::vector<DeviceInfo> devices_;
+		std::array<char, BUFFER_SIZE> buffer_{};
+
+		bool receive(std::vector<HotplugEvent>& events);
+		void handle(const detail::Uevent& uevent, std::vector<HotplugEvent>& events);
+		void resynchronize(std::vector<HotplugEvent>& events);
+	};
+}
+
+#endif //DUAL_SENSE_HID_HOTPLUG_MONITOR_HPP
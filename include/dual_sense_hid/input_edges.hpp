@@ -0,0 +1,124 @@
+#ifndef DUAL_SENSE_HID_INPUT_EDGES_HPP
+#define DUAL_SENSE_HID_INPUT_EDGES_HPP
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+#include "enums.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Tracker of button edges (pressed/released since previous report) and hold durations
+	 * @see Gamepad::edges
+	 */
+	class InputEdges
+	{
+	public:
+		/**
+		 * @brief Feed tracker with buttons state of next report
+		 * @param buttons Mask of pressed buttons
+		 * @param timestamp Report time in microseconds
+		 */
+		void update(uint32_t buttons, uint64_t timestamp)
+		{
+			const auto changed = buttons ^ held_;
+
+			pressed_ = changed & buttons;
+			released_ = changed & held_;
+			held_ = buttons;
+			timestamp_ = timestamp;
+
+			for(auto pressed = pressed_; pressed != 0; pressed &= pressed - 1)
+			{
+				press_timestamps_[static_cast<size_t>(std::countr_zero(pressed))] = timestamp;
+			}
+		}
+
+		/**
+		 * @brief Get mask of buttons pressed in last report
+		 * @return Mask of buttons which were up in previous report and are down in last one
+		 */
+		[[nodiscard]] uint32_t pressed_mask() const
+		{
+			return pressed_;
+		}
+
+		/**
+		 * @brief Get mask of buttons released in last report
+		 * @return Mask of buttons which were down in previous report and are up in last one
+		 */
+		[[nodiscard]] uint32_t released_mask() const
+		{
+			return released_;
+		}
+
+		/**
+		 * @brief Get mask of buttons down in last report
+		 * @return Mask of buttons down in last report
+		 */
+		[[nodiscard]] uint32_t held_mask() const
+		{
+			return held_;
+		}
+
+		/**
+		 * @brief Check if button was pressed in last report
+		 * @param button Button to check
+		 * @return true if button went down in last report
+		 */
+		[[nodiscard]] bool pressed(Button button) const
+		{
+			return (pressed_ & button_mask(button)) != 0;
+		}
+
+		/**
+		 * @brief Check if button was released in last report
+		 * @param button Button to check
+		 * @return true if button went up in last report
+		 */
+		[[nodiscard]] bool released(Button button) const
+		{
+			return (released_ & button_mask(button)) != 0;
+		}
+
+		/**
+		 * @brief Check if button is down
+		 * @param button Button to check
+		 * @return true if button is down in last report
+		 */
+		[[nodiscard]] bool held(Button button) const
+		{
+			return (held_ & button_mask(button)) != 0;
+		}
+
+		/**
+		 * @brief Get time for which button is held
+		 * @param button Button to check
+		 * @return Time between report in which button went down and last report, zero if button is up
+		 */
+		[[nodiscard]] std::chrono::microseconds hold_duration(Button button) const
+		{
+			if(!held(button))
+			{
+				return std::chrono::microseconds::zero();
+			}
+
+			const auto pressed_at = press_timestamps_[static_cast<uint8_t>(button)];
+			return std::chrono::microseconds(static_cast<std::chrono::microseconds::rep>(timestamp_ - pressed_at));
+		}
+
+	private:
+		uint32_t held_ = 0;
+		uint32_t pressed_ = 0;
+		uint32_t released_ = 0;
+
+		uint64_t timestamp_ = 0;
+		std::array<uint64_t, BUTTON_COUNT> press_timestamps_{};
+	};
+}
+
+#endif //DUAL_SENSE_HID_INPUT_EDGES_HPP
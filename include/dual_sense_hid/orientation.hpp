@@ -0,0 +1,137 @@
+#ifndef DUAL_SENSE_HID_ORIENTATION_HPP
+#define DUAL_SENSE_HID_ORIENTATION_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "state.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Unit quaternion describing orientation of gamepad
+	 * @note Axes follow sensor frame: x - pitch axis, y - yaw axis, z - roll axis
+	 */
+	struct Quaternion
+	{
+		float w = 1.0f; /*!< Scalar part */
+		float x = 0.0f; /*!< X component of vector part */
+		float y = 0.0f; /*!< Y component of vector part */
+		float z = 0.0f; /*!< Z component of vector part */
+	};
+
+	/**
+	 * @brief Madgwick orientation filter fusing calibrated gyroscope and accelerometer readings
+	 *
+	 * Time step of each update is taken from device sensor timestamps, so dropped or delayed
+	 * reports don't distort integration.
+	 */
+	class MadgwickFilter
+	{
+	public:
+		/**
+		 * @brief Default gain of accelerometer correction
+		 */
+		static constexpr float DEFAULT_BETA = 0.1f;
+
+		/**
+		 * @brief Create filter starting from identity orientation
+		 * @param beta Gain of accelerometer correction. Higher values converge faster but let more noise in
+		 */
+		explicit MadgwickFilter(float beta = DEFAULT_BETA);
+
+		/**
+		 * @brief Feed filter with next state
+		 * @param state State decoded with calibration data. First state only initializes time base
+		 */
+		void update(const State& state);
+
+		/**
+		 * @brief Feed filter with single sample
+		 * @param gyro Calibrated gyroscope reading
+		 * @param acceleration Calibrated accelerometer reading
+		 * @param dt_us Time elapsed since previous sample in microseconds
+		 */
+		void update(const State::Gyro& gyro, const State::Acceleration& acceleration, uint64_t dt_us);
+
+		/**
+		 * @brief Get current orientation
+		 * @return Current orientation
+		 */
+		[[nodiscard]] const Quaternion& orientation() const;
+
+		/**
+		 * @brief Reset orientation to identity and forget time base
+		 */
+		void reset();
+
+	private:
+		float beta_;
+		Quaternion orientation_;
+
+		bool initialized_ = false;
+		uint64_t last_timestamp_ = 0;
+	};
+
+	/**
+	 * @brief Integer-only variant of MadgwickFilter
+	 *
+	 * Quaternion and intermediate values are kept in Q2.28 fixed point format,
+	 * for targets without fast floating point unit.
+	 */
+	class FixedMadgwickFilter
+	{
+	public:
+		/**
+		 * @brief Number of fractional bits of fixed point values
+		 */
+		static constexpr int FRACTION_BITS = 28;
+
+		/**
+		 * @brief Create filter starting from identity orientation
+		 * @param beta Gain of accelerometer correction in Q2.28 format
+		 */
+		explicit FixedMadgwickFilter(int32_t beta = static_cast<int32_t>(MadgwickFilter::DEFAULT_BETA * (1 << FRACTION_BITS)));
+
+		/**
+		 * @brief Feed filter with next state
+		 * @param state State decoded with calibration data. First state only initializes time base
+		 */
+		void update(const State& state);
+
+		/**
+		 * @brief Feed filter with single sample
+		 * @param gyro Calibrated gyroscope reading
+		 * @param acceleration Calibrated accelerometer reading
+		 * @param dt_us Time elapsed since previous sample in microseconds
+		 */
+		void update(const State::Gyro& gyro, const State::Acceleration& acceleration, uint64_t dt_us);
+
+		/**
+		 * @brief Get current orientation in Q2.28 format (w, x, y, z)
+		 * @return Current orientation
+		 */
+		[[nodiscard]] const std::array<int32_t, 4>& raw_orientation() const;
+
+		/**
+		 * @brief Get current orientation converted to floating point
+		 * @return Current orientation
+		 */
+		[[nodiscard]] Quaternion orientation() const;
+
+		/**
+		 * @brief Reset orientation to identity and forget time base
+		 */
+		void reset();
+
+	private:
+		int32_t beta_;
+		std::array<int32_t, 4> orientation_;
+
+		bool initialized_ = false;
+		uint64_t last_timestamp_ = 0;
+	};
+}
+
+#endif //DUAL_SENSE_HID_ORIENTATION_HPP
@@ -0,0 +1,77 @@
+#ifndef DUAL_SENSE_HID_OUTPUT_SCHEDULER_HPP
+#define DUAL_SENSE_HID_OUTPUT_SCHEDULER_HPP
+
+#include <chrono>
+
+#include "gamepad.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Minimal spacing of output reports per connection type
+	 */
+	struct OutputSchedulerConfig
+	{
+		/** Minimal interval between reports over USB (default: 250 Hz) */
+		std::chrono::microseconds usb_interval = std::chrono::microseconds(4000);
+		/** Minimal interval between reports over Bluetooth (default: ~60 Hz) */
+		std::chrono::microseconds bluetooth_interval = std::chrono::microseconds(16000);
+	};
+
+	/**
+	 * @brief Rate limited flushing of gamepad output state
+	 *
+	 * Mutations done through Gamepad::Lights only mark sections dirty, so any number of them
+	 * between flushes ends up in single report. Scheduler writes that report at most once per
+	 * configured interval and only if something changed.
+	 */
+	class OutputScheduler
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		 * @brief Constructor
+		 * @param gamepad Gamepad to flush. Must outlive scheduler
+		 * @param config Report spacing settings
+		 */
+		explicit OutputScheduler(Gamepad& gamepad, const OutputSchedulerConfig& config = {});
+
+		/**
+		 * @brief Flush pending changes if minimal interval since last report elapsed
+		 *
+		 * Intended to be called once per frame or loop iteration.
+		 * @param now Current time
+		 * @return true if report was written
+		 */
+		bool tick(Clock::time_point now = Clock::now());
+
+		/**
+		 * @brief Flush pending changes immediately, ignoring rate limit
+		 * @param now Current time
+		 * @return true if report was written
+		 */
+		bool flush(Clock::time_point now = Clock::now());
+
+		/**
+		 * @brief Get earliest time next report may be written
+		 * @return Time point of next allowed flush
+		 */
+		[[nodiscard]] Clock::time_point next_flush() const;
+
+		/**
+		 * @brief Get minimal interval used for gamepad's connection type
+		 * @return Minimal interval between reports
+		 */
+		[[nodiscard]] std::chrono::microseconds interval() const;
+
+	private:
+		Gamepad& gamepad_;
+		std::chrono::microseconds interval_;
+
+		Clock::time_point last_flush_ = Clock::time_point::min();
+	};
+}
+
+#endif //DUAL_SENSE_HID_OUTPUT_SCHEDULER_HPP
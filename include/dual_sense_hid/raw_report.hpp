@@ -0,0 +1,270 @@
+#ifndef DUAL_SENSE_HID_RAW_REPORT_HPP
+#define DUAL_SENSE_HID_RAW_REPORT_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "enums.hpp"
+#include "state.hpp"
+#include "detail/helper.hpp"
+#include "detail/report_input.hpp"
+
+
+namespace dual_sense_hid
+{
+	namespace detail
+	{
+		inline State::TouchPoint extract_touch_point(const uint8_t touch_data[4])
+		{
+			const auto x = static_cast<uint16_t>(((touch_data[2] & 0x0f) << 8) | touch_data[1]);
+			const auto y = static_cast<uint16_t>((touch_data[3] << 4) | ((touch_data[2] & 0xf0) >> 4));
+
+			return
+					{
+							(touch_data[0] & 0x80) == 0,
+							x, y,
+							static_cast<uint8_t>(touch_data[0] & 0x7f)
+					};
+		}
+
+		inline int32_t extract_axis(uint16_t value)
+		{
+			return static_cast<int32_t>(std::bit_cast<int16_t>(le_to_native(value)));
+		}
+
+		inline uint32_t extract_uint32(const uint8_t data[4])
+		{
+			return static_cast<uint32_t>(data[0])
+				| (static_cast<uint32_t>(data[1]) << 8)
+				| (static_cast<uint32_t>(data[2]) << 16)
+				| (static_cast<uint32_t>(data[3]) << 24);
+		}
+	}
+
+	/**
+	 * @brief Undecoded input report
+	 *
+	 * Accessors decode requested fields directly from report bytes, so reading a few fields
+	 * costs only these fields. Gyroscope and accelerometer readings are not calibrated.
+	 * @see Gamepad::poll_raw
+	 * @see Gamepad::decode
+	 */
+	class RawReport
+	{
+	public:
+		/**
+		 * @brief Get type of connection report was received with
+		 * @return Type of connection
+		 */
+		[[nodiscard]] ConnectionType connection_type() const
+		{
+			return connection_type_;
+		}
+
+		/**
+		 * @brief Get left stick state
+		 * @return Left stick state
+		 */
+		[[nodiscard]] State::AnalogPad left_pad() const
+		{
+			return {common().left_pad_x, common().left_pad_y};
+		}
+
+		/**
+		 * @brief Get right stick state
+		 * @return Right stick state
+		 */
+		[[nodiscard]] State::AnalogPad right_pad() const
+		{
+			return {common().right_pad_x, common().right_pad_y};
+		}
+
+		/**
+		 * @brief Get left trigger state
+		 * @return Left trigger state
+		 */
+		[[nodiscard]] State::Trigger left_trigger() const
+		{
+			return {common().left_trigger, common().left_trigger_feedback};
+		}
+
+		/**
+		 * @brief Get right trigger state
+		 * @return Right trigger state
+		 */
+		[[nodiscard]] State::Trigger right_trigger() const
+		{
+			return {common().right_trigger, common().right_trigger_feedback};
+		}
+
+		/**
+		 * @brief Get direction of pressed DigitalPad buttons
+		 * @return Direction of pressed DigitalPad buttons
+		 */
+		[[nodiscard]] State::DPadDirection dpad_direction() const
+		{
+			return static_cast<State::DPadDirection>(common().buttons.dpad);
+		}
+
+		/**
+		 * @brief Get state of right button pad (circle, square, triangle, cross)
+		 * @return State of right button pad
+		 */
+		[[nodiscard]] State::ButtonPad button_pad() const
+		{
+			const auto& buttons = common().buttons;
+
+			return
+				{
+					static_cast<bool>(buttons.triangle),
+					static_cast<bool>(buttons.circle),
+					static_cast<bool>(buttons.cross),
+					static_cast<bool>(buttons.square)
+				};
+		}
+
+		/**
+		 * @brief Get state of other buttons
+		 * @return State of other buttons
+		 */
+		[[nodiscard]] State::Buttons buttons() const
+		{
+			const auto& buttons = common().buttons;
+
+			return
+				{
+					static_cast<bool>(buttons.l1),
+					static_cast<bool>(buttons.r1),
+					static_cast<bool>(buttons.l2),
+					static_cast<bool>(buttons.r2),
+					static_cast<bool>(buttons.create),
+					static_cast<bool>(buttons.menu),
+					static_cast<bool>(buttons.l3),
+					static_cast<bool>(buttons.r3),
+					static_cast<bool>(buttons.home),
+					static_cast<bool>(buttons.touchpad),
+					static_cast<bool>(buttons.mute)
+				};
+		}
+
+		/**
+		 * @brief Get uncalibrated gyroscope reading
+		 * @return Uncalibrated gyroscope reading
+		 */
+		[[nodiscard]] State::Gyro gyro() const
+		{
+			return
+				{
+					detail::extract_axis(common().gyro_pitch),
+					detail::extract_axis(common().gyro_yaw),
+					detail::extract_axis(common().gyro_roll)
+				};
+		}
+
+		/**
+		 * @brief Get uncalibrated accelerometer reading
+		 * @return Uncalibrated accelerometer reading
+		 */
+		[[nodiscard]] State::Acceleration acceleration() const
+		{
+			return
+				{
+					detail::extract_axis(common().acceleration_x),
+					detail::extract_axis(common().acceleration_y),
+					detail::extract_axis(common().acceleration_z)
+				};
+		}
+
+		/**
+		 * @brief Get gamepad temperature
+		 * @return Gamepad temperature
+		 */
+		[[nodiscard]] uint8_t temperature() const
+		{
+			return common().temperature;
+		}
+
+		/**
+		 * @brief Get first touch point
+		 * @return First touch point
+		 */
+		[[nodiscard]] State::TouchPoint touch_point_0() const
+		{
+			return detail::extract_touch_point(common().touch_data_0);
+		}
+
+		/**
+		 * @brief Get second touch point
+		 * @return Second touch point
+		 */
+		[[nodiscard]] State::TouchPoint touch_point_1() const
+		{
+			return detail::extract_touch_point(common().touch_data_1);
+		}
+
+		/**
+		 * @brief Get battery state
+		 * @return Battery state
+		 */
+		[[nodiscard]] State::Battery battery() const
+		{
+			return {common().battery_level, static_cast<State::PowerStatus>(common().power_status)};
+		}
+
+		/**
+		 * @brief Get state of connected headphones and internal mic
+		 * @return Audio state
+		 */
+		[[nodiscard]] State::Audio audio() const
+		{
+			return
+				{
+					static_cast<bool>(common().muted),
+					static_cast<bool>(common().headphones),
+					static_cast<bool>(common().microphone)
+				};
+		}
+
+		/**
+		 * @brief Get raw device sensor timestamp
+		 * @return 32-bit wrapping counter in 1/3 microsecond units
+		 */
+		[[nodiscard]] uint32_t sensor_timestamp() const
+		{
+			return detail::extract_uint32(common().sensor_timestamp);
+		}
+
+		/**
+		 * @brief Get host time of report reception
+		 * @return Steady clock time in microseconds
+		 */
+		[[nodiscard]] uint64_t host_timestamp() const
+		{
+			return host_timestamp_;
+		}
+
+		/**
+		 * @brief Get report part common for all connection types
+		 * @return Report part common for all connection types
+		 */
+		[[nodiscard]] const detail::ReportCommon& common() const
+		{
+			if(connection_type_ == ConnectionType::USB)
+			{
+				return reinterpret_cast<const detail::ReportUSB*>(data_.data())->common;
+			}
+
+			return reinterpret_cast<const detail::ReportBT*>(data_.data())->common;
+		}
+
+	private:
+		alignas(8) std::array<uint8_t, sizeof(detail::ReportBT)> data_;
+		ConnectionType connection_type_ = ConnectionType::USB;
+		uint64_t host_timestamp_ = 0;
+
+		friend class Gamepad;
+	};
+}
+
+#endif //DUAL_SENSE_HID_RAW_REPORT_HPP
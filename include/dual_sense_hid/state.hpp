@@ -130,6 +130,19 @@ namespace dual_sense_hid
 			int32_t z; /*!< Z axis acceleration */
 		};
 
+		/**
+		 * @brief Timing of report
+		 *
+		 * @note Device timestamps are extended past 32-bit counter wraparound, so they are monotonic
+		 * as long as reports of gamepad are processed in order
+		 */
+		struct Timestamps
+		{
+			uint64_t sensor; /*!< Device time of gyroscope and accelerometer sampling in microseconds */
+			uint64_t host; /*!< Host steady clock time of report reception in microseconds */
+			uint8_t touch; /*!< Touchpad sampling counter */
+		};
+
 		/**
 		 * @brief State of analog pad
 		 */
@@ -191,6 +204,8 @@ namespace dual_sense_hid
 		Battery battery; /*!< Battery state (level, charging, charged) */
 
 		Audio audio; /*!< State of connected headphones and internal mic */
+
+		Timestamps timestamps; /*!< Device and host timestamps of report */
 	};
 }
 
@@ -0,0 +1,93 @@
+#ifndef DUAL_SENSE_HID_URING_READER_HPP
+#define DUAL_SENSE_HID_URING_READER_HPP
+
+#include <chrono>
+#include <memory>
+#include <stop_token>
+#include <vector>
+
+#include "gamepad.hpp"
+#include "gamepad_hub.hpp"
+
+
+namespace dual_sense_hid
+{
+	/**
+	 * @brief Batched io_uring report reader for large number of gamepads
+	 *
+	 * Keeps read of next report in flight for every gamepad and harvests completions in batches,
+	 * so many reports cost single syscall. Reports go through the same processing as Gamepad::try_poll.
+	 * When io_uring is unavailable (old kernel, disabled by seccomp, etc.) GamepadHub is used instead.
+	 * @note Only gamepads opened with Backend::HIDRAW can be added
+	 */
+	class UringReader
+	{
+	public:
+		using Callback = GamepadHub::Callback; /*!< Callback receiving decoded state of gamepad */
+		using DisconnectCallback = GamepadHub::DisconnectCallback; /*!< Callback called when gamepad fails */
+
+		/**
+		 * @brief Constructor
+		 * @param callback Function called with every decoded state
+		 * @param disconnect_callback Function called when gamepad fails to read (optional)
+		 * @param queue_depth Submission queue size. Two entries are used per gamepad
+		 */
+		explicit UringReader(Callback callback, DisconnectCallback disconnect_callback = {}, unsigned queue_depth = 256);
+
+		UringReader(const UringReader&) = delete;
+		UringReader& operator=(const UringReader&) = delete;
+
+		~UringReader();
+
+		/**
+		 * @brief Check if io_uring is used
+		 * @return false if reader fell back to epoll
+		 */
+		[[nodiscard]] bool uses_io_uring() const;
+
+		/**
+		 * @brief Add gamepad to reader. Gamepad must outlive its membership in reader
+		 * @param gamepad Gamepad opened with Backend::HIDRAW, without running reader thread
+		 * @param use_calibration_data Apply accelerometer & gyroscope calibration data to readings
+		 */
+		void add(Gamepad& gamepad, bool use_calibration_data = true);
+
+		/**
+		 * @brief Remove gamepad from reader
+		 * @param gamepad Gamepad previously added
+		 */
+		void remove(Gamepad& gamepad);
+
+		/**
+		 * @brief Submit pending reads, wait for completions and dispatch all completed reports
+		 * @note Exceptions thrown by callback are propagated, remaining completions are dispatched in next call
+		 * @param timeout Maximum wait time (negative - wait indefinitely)
+		 * @return Number of dispatched states
+		 */
+		std::size_t run_once(std::chrono::milliseconds timeout);
+
+		/**
+		 * @brief Dispatch reports until stop is requested
+		 * @param stop_token Token stopping loop
+		 */
+		void run(const std::stop_token& stop_token);
+
+	private:
+		struct Ring;
+		struct Entry;
+
+		Callback callback_;
+		DisconnectCallback disconnect_callback_;
+
+		std::unique_ptr<Ring> ring_;
+		std::unique_ptr<GamepadHub> fallback_;
+
+		std::vector<std::unique_ptr<Entry>> entries_;
+
+		void submit_read(Entry& entry);
+		void cancel(Entry& entry);
+		void release(Entry& entry);
+	};
+}
+
+#endif //DUAL_SENSE_HID_URING_READER_HPP
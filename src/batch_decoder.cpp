@@ -0,0 +1,217 @@
+#include "dual_sense_hid/batch_decoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include "dual_sense_hid/raw_report.hpp"
+#include "dual_sense_hid/detail/report_input.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DUAL_SENSE_HID_AVX2
+#include <immintrin.h>
+#endif
+
+
+namespace dual_sense_hid
+{
+	namespace
+	{
+		inline std::array<std::span<int32_t>, 6> motion_outputs(const MotionBatch& out)
+		{
+			return {out.gyro_pitch, out.gyro_yaw, out.gyro_roll, out.acceleration_x, out.acceleration_y, out.acceleration_z};
+		}
+
+		inline std::array<std::span<uint8_t>, 6> analog_outputs(const MotionBatch& out)
+		{
+			return {out.left_pad_x, out.left_pad_y, out.right_pad_x, out.right_pad_y, out.left_trigger, out.right_trigger};
+		}
+	}
+
+	BatchDecoder::BatchDecoder(ConnectionType connection_type)
+		:connection_type_(connection_type)
+	{}
+
+	BatchDecoder::BatchDecoder(ConnectionType connection_type, const Calibration& calibration)
+		:connection_type_(connection_type), calibration_(detail::CalibrationKernel::from_calibration(calibration))
+	{}
+
+	std::size_t BatchDecoder::decode(std::span<const uint8_t> reports, const MotionBatch& out) const
+	{
+		const auto count = reports.size() / report_size();
+
+		const auto fits = [count](const auto& span)
+		{
+			return span.size() >= count;
+		};
+		if(!std::ranges::all_of(motion_outputs(out), fits) || !std::ranges::all_of(analog_outputs(out), fits))
+		{
+			throw std::invalid_argument("Batch buffers are smaller than number of reports");
+		}
+
+		const auto common_offset = connection_type_ == ConnectionType::USB
+				? offsetof(detail::ReportUSB, common)
+				: offsetof(detail::ReportBT, common);
+
+		const detail::BatchLayout layout {
+				reports.data() + common_offset,
+				report_size(),
+				calibration_ ? &*calibration_ : nullptr
+		};
+
+		const auto first = simd_supported() ? detail::decode_batch_avx2(layout, count, out) : 0;
+		detail::decode_batch_scalar(layout, first, count, out);
+
+		return count;
+	}
+
+	std::size_t BatchDecoder::report_size() const
+	{
+		return connection_type_ == ConnectionType::USB ? sizeof(detail::ReportUSB) : sizeof(detail::ReportBT);
+	}
+
+	bool BatchDecoder::simd_supported()
+	{
+#ifdef DUAL_SENSE_HID_AVX2
+		static const bool supported = __builtin_cpu_supports("avx2");
+		return supported;
+#else
+		return false;
+#endif
+	}
+
+	namespace detail
+	{
+		void decode_batch_scalar(const BatchLayout& layout, std::size_t first, std::size_t count, const MotionBatch& out)
+		{
+			const auto motion_out = motion_outputs(out);
+			const auto analog_out = analog_outputs(out);
+
+			for(auto i = first; i < count; ++i)
+			{
+				const auto& common = *reinterpret_cast<const ReportCommon*>(layout.common + i * layout.stride);
+
+				std::array<int32_t, CalibrationKernel::LANES> motion = {
+						extract_axis(common.gyro_pitch),
+						extract_axis(common.gyro_yaw),
+						extract_axis(common.gyro_roll),
+						extract_axis(common.acceleration_x),
+						extract_axis(common.acceleration_y),
+						extract_axis(common.acceleration_z),
+						0,
+						0
+				};
+				if(layout.calibration)
+				{
+					motion = layout.calibration->apply(motion);
+				}
+
+				for(size_t axis = 0; axis < motion_out.size(); ++axis)
+				{
+					motion_out[axis][i] = motion[axis];
+				}
+
+				const std::array<uint8_t, 6> analog = {
+						common.left_pad_x, common.left_pad_y,
+						common.right_pad_x, common.right_pad_y,
+						common.left_trigger, common.right_trigger
+				};
+				for(size_t field = 0; field < analog_out.size(); ++field)
+				{
+					analog_out[field][i] = analog[field];
+				}
+			}
+		}
+
+#ifdef DUAL_SENSE_HID_AVX2
+		namespace
+		{
+			/**
+			 * @brief Transpose bytes of dwords gathered from 8 reports
+			 * @return Byte k of every report packed in 64-bit element k
+			 */
+			__attribute__((target("avx2")))
+			inline std::array<uint64_t, 4> transpose_bytes(__m256i dwords)
+			{
+				const auto by_byte = _mm256_shuffle_epi8(
+						dwords,
+						_mm256_setr_epi8(
+								0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+								0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15
+						)
+				);
+				const auto joined = _mm256_permutevar8x32_epi32(by_byte, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+
+				alignas(32) std::array<uint64_t, 4> result;
+				_mm256_store_si256(reinterpret_cast<__m256i*>(result.data()), joined);
+
+				return result;
+			}
+		}
+
+		__attribute__((target("avx2")))
+		std::size_t decode_batch_avx2(const BatchLayout& layout, std::size_t count, const MotionBatch& out)
+		{
+			static constexpr std::array<size_t, 6> MOTION_OFFSETS = {
+					offsetof(ReportCommon, gyro_pitch),
+					offsetof(ReportCommon, gyro_yaw),
+					offsetof(ReportCommon, gyro_roll),
+					offsetof(ReportCommon, acceleration_x),
+					offsetof(ReportCommon, acceleration_y),
+					offsetof(ReportCommon, acceleration_z)
+			};
+			static_assert(offsetof(ReportCommon, left_pad_x) == 0 && offsetof(ReportCommon, right_pad_y) == 3);
+			static_assert(offsetof(ReportCommon, left_trigger) == 4 && offsetof(ReportCommon, right_trigger) == 5);
+
+			const auto motion_out = motion_outputs(out);
+			const auto analog_out = analog_outputs(out);
+
+			const auto stride = static_cast<int>(layout.stride);
+			const auto indices = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+
+			std::size_t i = 0;
+			for(; i + 8 <= count; i += 8)
+			{
+				const auto base = layout.common + i * layout.stride;
+
+				for(size_t axis = 0; axis < MOTION_OFFSETS.size(); ++axis)
+				{
+					const auto gathered = _mm256_i32gather_epi32(
+							reinterpret_cast<const int*>(base + MOTION_OFFSETS[axis]), indices, 1
+					);
+					// sign-extend low 16 bits
+					auto values = _mm256_srai_epi32(_mm256_slli_epi32(gathered, 16), 16);
+
+					if(layout.calibration)
+					{
+						const auto offset = _mm256_set1_ps(layout.calibration->offset[axis]);
+						const auto scale = _mm256_set1_ps(layout.calibration->scale[axis]);
+
+						values = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(values), offset), scale));
+					}
+
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(motion_out[axis].data() + i), values);
+				}
+
+				const auto sticks = transpose_bytes(_mm256_i32gather_epi32(reinterpret_cast<const int*>(base), indices, 1));
+				const auto triggers = transpose_bytes(_mm256_i32gather_epi32(reinterpret_cast<const int*>(base + 4), indices, 1));
+
+				for(size_t field = 0; field < 4; ++field)
+				{
+					std::memcpy(analog_out[field].data() + i, &sticks[field], sizeof(uint64_t));
+				}
+				std::memcpy(analog_out[4].data() + i, &triggers[0], sizeof(uint64_t));
+				std::memcpy(analog_out[5].data() + i, &triggers[1], sizeof(uint64_t));
+			}
+
+			return i;
+		}
+#else
+		std::size_t decode_batch_avx2(const BatchLayout&, std::size_t, const MotionBatch&)
+		{
+			return 0;
+		}
+#endif
+	}
+}
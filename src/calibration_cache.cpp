@@ -0,0 +1,230 @@
+#include "dual_sense_hid/calibration_cache.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <system_error>
+#include <thread>
+
+#include "dual_sense_hid/detail/calibration_report.hpp"
+#include "dual_sense_hid/detail/crc32.hpp"
+#include "dual_sense_hid/detail/transport.hpp"
+
+static constexpr std::array<char, 4> ENTRY_MAGIC = {'D', 'S', 'C', 'C'};
+static constexpr uint16_t ENTRY_VERSION = 1;
+
+
+namespace dual_sense_hid
+{
+	namespace
+	{
+		constexpr size_t FIELD_COUNT = 14;
+
+		// magic, version, field count, fields, checksum
+		constexpr size_t CHECKSUM_OFFSET = ENTRY_MAGIC.size() + 2 + 2 + FIELD_COUNT * sizeof(int32_t);
+		constexpr size_t ENTRY_SIZE = CHECKSUM_OFFSET + sizeof(uint32_t);
+
+		using Entry = std::array<uint8_t, ENTRY_SIZE>;
+
+		std::array<int32_t*, FIELD_COUNT> fields(Calibration& calibration)
+		{
+			auto& gyro = calibration.gyroscope;
+			auto& accel = calibration.accelerometer;
+
+			return
+				{
+					&gyro.factor_numerator,
+					&gyro.pitch_factor_denominator, &gyro.pitch_offset,
+					&gyro.yaw_factor_denominator, &gyro.yaw_offset,
+					&gyro.roll_factor_denominator, &gyro.roll_offset,
+					&accel.factor_numerator,
+					&accel.x_factor_denominator, &accel.x_offset,
+					&accel.y_factor_denominator, &accel.y_offset,
+					&accel.z_factor_denominator, &accel.z_offset
+				};
+		}
+
+		inline void put_le(uint8_t* destination, uint32_t value, size_t size)
+		{
+			for(size_t i = 0; i < size; ++i)
+			{
+				destination[i] = static_cast<uint8_t>(value >> (8 * i));
+			}
+		}
+
+		inline uint32_t get_le(const uint8_t* source, size_t size)
+		{
+			uint32_t value = 0;
+			for(size_t i = 0; i < size; ++i)
+			{
+				value |= static_cast<uint32_t>(source[i]) << (8 * i);
+			}
+
+			return value;
+		}
+
+		Entry serialize(Calibration calibration)
+		{
+			Entry entry{};
+
+			std::memcpy(entry.data(), ENTRY_MAGIC.data(), ENTRY_MAGIC.size());
+			put_le(entry.data() + 4, ENTRY_VERSION, 2);
+			put_le(entry.data() + 6, FIELD_COUNT, 2);
+
+			auto* position = entry.data() + 8;
+			for(const auto field: fields(calibration))
+			{
+				put_le(position, static_cast<uint32_t>(*field), sizeof(int32_t));
+				position += sizeof(int32_t);
+			}
+
+			put_le(entry.data() + CHECKSUM_OFFSET, detail::crc32(entry.data(), CHECKSUM_OFFSET), sizeof(uint32_t));
+
+			return entry;
+		}
+
+		std::optional<Calibration> deserialize(const Entry& entry)
+		{
+			const auto valid = std::memcmp(entry.data(), ENTRY_MAGIC.data(), ENTRY_MAGIC.size()) == 0
+					&& get_le(entry.data() + 4, 2) == ENTRY_VERSION
+					&& get_le(entry.data() + 6, 2) == FIELD_COUNT
+					&& get_le(entry.data() + CHECKSUM_OFFSET, sizeof(uint32_t)) == detail::crc32(entry.data(), CHECKSUM_OFFSET);
+			if(!valid)
+			{
+				return std::nullopt;
+			}
+
+			Calibration calibration{};
+
+			const auto* position = entry.data() + 8;
+			for(const auto field: fields(calibration))
+			{
+				*field = static_cast<int32_t>(get_le(position, sizeof(int32_t)));
+				position += sizeof(int32_t);
+			}
+
+			return calibration;
+		}
+	}
+
+	CalibrationCache::CalibrationCache(std::filesystem::path directory)
+		:directory_(std::move(directory))
+	{}
+
+	std::optional<Calibration> CalibrationCache::load(const std::string& serial) const
+	{
+		if(serial.empty())
+		{
+			return std::nullopt;
+		}
+
+		std::ifstream file(entry_path(serial), std::ios::binary);
+		if(!file)
+		{
+			return std::nullopt;
+		}
+
+		Entry entry;
+		file.read(reinterpret_cast<char*>(entry.data()), static_cast<std::streamsize>(entry.size()));
+		if(file.gcount() != static_cast<std::streamsize>(entry.size()) || file.peek() != std::ifstream::traits_type::eof())
+		{
+			return std::nullopt;
+		}
+
+		return deserialize(entry);
+	}
+
+	bool CalibrationCache::store(const std::string& serial, const Calibration& calibration) const
+	{
+		if(serial.empty())
+		{
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(directory_, error);
+		if(error)
+		{
+			return false;
+		}
+
+		const auto path = entry_path(serial);
+
+		// written aside and renamed, so concurrent readers never see partial entry
+		auto temporary = path;
+		temporary += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+		{
+			const auto entry = serialize(calibration);
+
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(entry.data()), static_cast<std::streamsize>(entry.size()));
+			if(!file.flush())
+			{
+				file.close();
+				std::filesystem::remove(temporary, error);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporary, path, error);
+		if(error)
+		{
+			std::filesystem::remove(temporary, error);
+			return false;
+		}
+
+		return true;
+	}
+
+	void CalibrationCache::invalidate(const std::string& serial) const
+	{
+		if(serial.empty())
+		{
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::remove(entry_path(serial), error);
+	}
+
+	std::future<Calibration> CalibrationCache::refresh(const DeviceInfo& device_info) const
+	{
+		return std::async(
+				std::launch::async,
+				[cache = *this, device_info]()
+				{
+					const auto transport = detail::open_transport(device_info.path, device_info.backend);
+					const auto calibration = detail::fetch_calibration(*transport);
+
+					cache.store(device_info.serial, calibration);
+
+					return calibration;
+				}
+		);
+	}
+
+	const std::filesystem::path& CalibrationCache::directory() const
+	{
+		return directory_;
+	}
+
+	std::filesystem::path CalibrationCache::entry_path(const std::string& serial) const
+	{
+		// serials are MAC addresses, ':' isn't allowed in file names on every platform
+		std::string name;
+		name.reserve(serial.size() + 4);
+		for(const auto character: serial)
+		{
+			const auto allowed = (character >= '0' && character <= '9')
+					|| (character >= 'a' && character <= 'z')
+					|| (character >= 'A' && character <= 'Z')
+					|| character == '-';
+			name.push_back(allowed ? character : '_');
+		}
+		name += ".cal";
+
+		return directory_ / name;
+	}
+}
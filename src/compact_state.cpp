@@ -0,0 +1,158 @@
+#include "dual_sense_hid/compact_state.hpp"
+
+#include "dual_sense_hid/detail/buttons.hpp"
+
+
+namespace dual_sense_hid
+{
+	namespace
+	{
+		constexpr std::array<State::DPadDirection, 16> mask_to_direction {
+				State::DPadDirection::NONE,         // none
+				State::DPadDirection::UP,           // up
+				State::DPadDirection::RIGHT,        // right
+				State::DPadDirection::UP_RIGHT,     // up, right
+				State::DPadDirection::DOWN,         // down
+				State::DPadDirection::NONE,         // down, up
+				State::DPadDirection::DOWN_RIGHT,   // down, right
+				State::DPadDirection::NONE,         // down, right, up
+				State::DPadDirection::LEFT,         // left
+				State::DPadDirection::UP_LEFT,      // left, up
+				State::DPadDirection::NONE,         // left, right
+				State::DPadDirection::NONE,         // left, right, up
+				State::DPadDirection::DOWN_LEFT,    // left, down
+				State::DPadDirection::NONE,         // left, down, up
+				State::DPadDirection::NONE,         // left, down, right
+				State::DPadDirection::NONE          // all
+		};
+
+		inline uint32_t pack_touch_point(const State::TouchPoint& touch_point)
+		{
+			return (touch_point.x & 0xfffu)
+				| ((touch_point.y & 0xfffu) << 12)
+				| ((touch_point.id & 0x7fu) << 24)
+				| (touch_point.active ? 0x80000000u : 0u);
+		}
+
+		inline State::TouchPoint unpack_touch_point(uint32_t packed)
+		{
+			return
+				{
+					(packed & 0x80000000u) != 0,
+					static_cast<uint16_t>(packed & 0xfffu),
+					static_cast<uint16_t>((packed >> 12) & 0xfffu),
+					static_cast<uint8_t>((packed >> 24) & 0x7fu)
+				};
+		}
+
+		inline uint32_t bit(bool value, Button button)
+		{
+			return value ? button_mask(button) : 0u;
+		}
+	}
+
+	CompactState CompactState::from_state(const State& state)
+	{
+		CompactState compact{};
+
+		compact.sensor_timestamp = state.timestamps.sensor;
+		compact.host_timestamp = state.timestamps.host;
+
+		compact.gyro = {state.gyro.pitch, state.gyro.yaw, state.gyro.roll};
+		compact.acceleration = {state.acceleration.x, state.acceleration.y, state.acceleration.z};
+
+		compact.buttons = detail::DPAD_DIRECTION_MASK[static_cast<uint8_t>(state.dpad_direction) & 0x0f]
+			| bit(state.button_pad.square, Button::SQUARE)
+			| bit(state.button_pad.cross, Button::CROSS)
+			| bit(state.button_pad.circle, Button::CIRCLE)
+			| bit(state.button_pad.triangle, Button::TRIANGLE)
+			| bit(state.buttons.l1, Button::L1)
+			| bit(state.buttons.r1, Button::R1)
+			| bit(state.buttons.l2, Button::L2)
+			| bit(state.buttons.r2, Button::R2)
+			| bit(state.buttons.create, Button::CREATE)
+			| bit(state.buttons.menu, Button::MENU)
+			| bit(state.buttons.l3, Button::L3)
+			| bit(state.buttons.r3, Button::R3)
+			| bit(state.buttons.home, Button::HOME)
+			| bit(state.buttons.touchpad, Button::TOUCHPAD)
+			| bit(state.buttons.mute, Button::MUTE);
+
+		compact.touch_points = {pack_touch_point(state.touch_point_0), pack_touch_point(state.touch_point_1)};
+
+		compact.sticks = {state.left_pad.x, state.left_pad.y, state.right_pad.x, state.right_pad.y};
+		compact.triggers = {state.left_trigger.value, state.right_trigger.value};
+		compact.trigger_stop_locations = static_cast<uint8_t>(
+				(state.left_trigger.stop_location & 0x0f) | ((state.right_trigger.stop_location & 0x0f) << 4)
+		);
+
+		compact.temperature = state.temperature;
+		compact.battery = static_cast<uint8_t>(
+				(state.battery.level & 0x0f) | ((static_cast<uint8_t>(state.battery.power_status) & 0x0f) << 4)
+		);
+		compact.audio = static_cast<uint8_t>(
+				(state.audio.muted ? 0x01 : 0x00)
+				| (state.audio.headphones_connected ? 0x02 : 0x00)
+				| (state.audio.microphone_connected ? 0x04 : 0x00)
+		);
+		compact.touch_timestamp = state.timestamps.touch;
+
+		return compact;
+	}
+
+	State CompactState::to_state() const
+	{
+		return
+			{
+				{sticks[0], sticks[1]},
+				{sticks[2], sticks[3]},
+				{
+					triggers[0],
+					static_cast<uint8_t>(trigger_stop_locations & 0x0f)
+				},
+				{
+					triggers[1],
+					static_cast<uint8_t>(trigger_stop_locations >> 4)
+				},
+				mask_to_direction[buttons & 0x0f],
+				{
+					pressed(Button::TRIANGLE),
+					pressed(Button::CIRCLE),
+					pressed(Button::CROSS),
+					pressed(Button::SQUARE)
+				},
+				{
+					pressed(Button::L1),
+					pressed(Button::R1),
+					pressed(Button::L2),
+					pressed(Button::R2),
+					pressed(Button::CREATE),
+					pressed(Button::MENU),
+					pressed(Button::L3),
+					pressed(Button::R3),
+					pressed(Button::HOME),
+					pressed(Button::TOUCHPAD),
+					pressed(Button::MUTE)
+				},
+				{gyro[0], gyro[1], gyro[2]},
+				{acceleration[0], acceleration[1], acceleration[2]},
+				temperature,
+				unpack_touch_point(touch_points[0]),
+				unpack_touch_point(touch_points[1]),
+				{
+					static_cast<uint8_t>(battery & 0x0f),
+					static_cast<State::PowerStatus>(battery >> 4)
+				},
+				{
+					(audio & 0x01) != 0,
+					(audio & 0x02) != 0,
+					(audio & 0x04) != 0
+				},
+				{
+					sensor_timestamp,
+					host_timestamp,
+					touch_timestamp
+				}
+			};
+	}
+}
@@ -0,0 +1,44 @@
+#include "dual_sense_hid/detail/hidapi_enumeration.hpp"
+
+#include <memory>
+
+#include <hidapi.h>
+
+#include "dual_sense_hid/gamepad.hpp"
+#include "dual_sense_hid/detail/helper.hpp"
+
+
+namespace dual_sense_hid::detail
+{
+	void visit_hidapi_devices(const std::function<void(const EnumeratedDevice&)>& visitor)
+	{
+		const std::unique_ptr<hid_device_info, decltype(&hid_free_enumeration)> enumerated(
+				hid_enumerate(VENDOR_ID, PRODUCT_ID),
+				&hid_free_enumeration
+		);
+
+		for(auto current = enumerated.get(); current != nullptr; current = current->next)
+		{
+			visitor(
+					{
+						current->path,
+						current->serial_number,
+						current->manufacturer_string,
+						current->product_string,
+						current->release_number == 0 ? ConnectionType::BLUETOOTH : ConnectionType::USB
+					}
+			);
+		}
+	}
+
+	DeviceInfo to_device_info(const EnumeratedDevice& device)
+	{
+		return DeviceInfo{
+				device.path,
+				wide_to_utf8(device.serial),
+				wide_to_utf8(device.manufacturer_string),
+				wide_to_utf8(device.product_string),
+				device.connection_type
+		};
+	}
+}
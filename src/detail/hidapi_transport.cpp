@@ -0,0 +1,62 @@
+#include "dual_sense_hid/detail/transport.hpp"
+
+#include <stdexcept>
+
+#include <hidapi.h>
+
+
+namespace dual_sense_hid::detail
+{
+	namespace
+	{
+		class HidapiTransport final: public Transport
+		{
+		public:
+			explicit HidapiTransport(hid_device* device)
+				:device_(device)
+			{}
+
+			HidapiTransport(const HidapiTransport&) = delete;
+			HidapiTransport& operator=(const HidapiTransport&) = delete;
+
+			~HidapiTransport() override
+			{
+				hid_close(device_);
+			}
+
+			int read(uint8_t* buffer, std::size_t size, int timeout_ms) override
+			{
+				return hid_read_timeout(device_, buffer, size, timeout_ms);
+			}
+
+			int write(const uint8_t* buffer, std::size_t size) override
+			{
+				return hid_write(device_, buffer, size);
+			}
+
+			int get_feature_report(uint8_t* buffer, std::size_t size) override
+			{
+				return hid_get_feature_report(device_, buffer, size);
+			}
+
+			[[nodiscard]] int native_handle() const override
+			{
+				return -1;
+			}
+
+		private:
+			hid_device* device_;
+		};
+	}
+
+	std::unique_ptr<Transport> open_hidapi_transport(const std::string& path)
+	{
+		const auto device = hid_open_path(path.c_str());
+		if (device == nullptr)
+		{
+			throw std::runtime_error("Failed to open device path");
+		}
+
+		return std::make_unique<HidapiTransport>(device);
+	}
+}
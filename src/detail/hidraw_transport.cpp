@@ -0,0 +1,97 @@
+#include "dual_sense_hid/detail/transport.hpp"
+
+#include <cerrno>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <linux/hidraw.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+
+namespace dual_sense_hid::detail
+{
+	namespace
+	{
+		class HidrawTransport final: public Transport
+		{
+		public:
+			explicit HidrawTransport(int fd)
+				:fd_(fd)
+			{}
+
+			HidrawTransport(const HidrawTransport&) = delete;
+			HidrawTransport& operator=(const HidrawTransport&) = delete;
+
+			~HidrawTransport() override
+			{
+				::close(fd_);
+			}
+
+			int read(uint8_t* buffer, std::size_t size, int timeout_ms) override
+			{
+				while(true)
+				{
+					const auto result = ::read(fd_, buffer, size);
+					if(result >= 0)
+					{
+						return static_cast<int>(result);
+					}
+					if(errno == EINTR)
+					{
+						continue;
+					}
+					if(errno != EAGAIN || timeout_ms == 0)
+					{
+						return errno == EAGAIN ? 0 : -1;
+					}
+
+					pollfd poll_fd{fd_, POLLIN, 0};
+					const auto ready = ::poll(&poll_fd, 1, timeout_ms);
+					if(ready == 0)
+					{
+						return 0;
+					}
+					if(ready < 0 && errno != EINTR)
+					{
+						return -1;
+					}
+					if((poll_fd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0)
+					{
+						return -1;
+					}
+				}
+			}
+
+			int write(const uint8_t* buffer, std::size_t size) override
+			{
+				return static_cast<int>(::write(fd_, buffer, size));
+			}
+
+			int get_feature_report(uint8_t* buffer, std::size_t size) override
+			{
+				return ::ioctl(fd_, HIDIOCGFEATURE(size), buffer);
+			}
+
+			[[nodiscard]] int native_handle() const override
+			{
+				return fd_;
+			}
+
+		private:
+			int fd_;
+		};
+	}
+
+	std::unique_ptr<Transport> open_hidraw_transport(const std::string& path)
+	{
+		const auto fd = ::open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+		if(fd < 0)
+		{
+			throw std::runtime_error("Failed to open device path");
+		}
+
+		return std::make_unique<HidrawTransport>(fd);
+	}
+}
@@ -0,0 +1,21 @@
+#include "dual_sense_hid/detail/transport.hpp"
+
+#include <stdexcept>
+
+
+namespace dual_sense_hid::detail
+{
+	std::unique_ptr<Transport> open_transport(const std::string& path, Backend backend)
+	{
+		if(backend == Backend::HIDRAW)
+		{
+#if defined(__linux__)
+			return open_hidraw_transport(path);
+#else
+			throw std::runtime_error("hidraw backend is not supported on this platform");
+#endif
+		}
+
+		return open_hidapi_transport(path);
+	}
+}
@@ -0,0 +1,103 @@
+#include "dual_sense_hid/detail/uevent.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+// struct udev_monitor_netlink_header: prefix, magic (big endian), header size, properties offset & length
+static constexpr std::string_view UDEV_PREFIX("libudev\0", 8);
+static constexpr std::array<unsigned char, 4> UDEV_MAGIC = {0xfe, 0xed, 0xca, 0xfe};
+static constexpr size_t UDEV_MAGIC_OFFSET = 8;
+static constexpr size_t UDEV_PROPERTIES_OFFSET = 16;
+static constexpr size_t UDEV_PROPERTIES_LENGTH = 20;
+static constexpr size_t UDEV_HEADER_MIN_SIZE = 24;
+
+
+namespace dual_sense_hid
+{
+	namespace
+	{
+		std::optional<std::string_view> udev_properties(std::string_view data)
+		{
+			if(data.size() < UDEV_HEADER_MIN_SIZE
+				|| std::memcmp(data.data() + UDEV_MAGIC_OFFSET, UDEV_MAGIC.data(), UDEV_MAGIC.size()) != 0)
+			{
+				return std::nullopt;
+			}
+
+			uint32_t offset;
+			uint32_t length;
+			std::memcpy(&offset, data.data() + UDEV_PROPERTIES_OFFSET, sizeof(offset));
+			std::memcpy(&length, data.data() + UDEV_PROPERTIES_LENGTH, sizeof(length));
+			if(offset > data.size() || length > data.size() - offset)
+			{
+				return std::nullopt;
+			}
+
+			return data.substr(offset, length);
+		}
+
+		std::optional<std::string_view> kernel_properties(std::string_view data)
+		{
+			const auto header_end = data.find('\0');
+			if(header_end == std::string_view::npos || data.substr(0, header_end).find('@') == std::string_view::npos)
+			{
+				return std::nullopt;
+			}
+
+			return data.substr(header_end + 1);
+		}
+	}
+
+	std::optional<detail::Uevent> detail::parse_uevent(std::span<const char> message)
+	{
+		const std::string_view data(message.data(), message.size());
+
+		const auto properties = data.starts_with(UDEV_PREFIX) ? udev_properties(data) : kernel_properties(data);
+		if(!properties)
+		{
+			return std::nullopt;
+		}
+
+		Uevent uevent;
+
+		auto remaining = *properties;
+		while(!remaining.empty())
+		{
+			const auto end = remaining.find('\0');
+			const auto property = remaining.substr(0, end);
+			remaining = end == std::string_view::npos ? std::string_view() : remaining.substr(end + 1);
+
+			const auto separator = property.find('=');
+			if(separator == std::string_view::npos)
+			{
+				continue;
+			}
+
+			const auto key = property.substr(0, separator);
+			const auto value = property.substr(separator + 1);
+
+			if(key == "ACTION")
+			{
+				uevent.action = value;
+			}
+			else if(key == "SUBSYSTEM")
+			{
+				uevent.subsystem = value;
+			}
+			else if(key == "DEVNAME")
+			{
+				// kernel reports bare node name, udev full /dev path
+				const auto slash = value.rfind('/');
+				uevent.devname = slash == std::string_view::npos ? value : value.substr(slash + 1);
+			}
+		}
+
+		if(uevent.action.empty() || uevent.subsystem.empty())
+		{
+			return std::nullopt;
+		}
+
+		return uevent;
+	}
+}
@@ -0,0 +1,67 @@
+#include "dual_sense_hid/enumeration_cache.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
+#include "dual_sense_hid/detail/hidapi_enumeration.hpp"
+
+
+namespace dual_sense_hid
+{
+	EnumerationCache::Changes EnumerationCache::rescan()
+	{
+		added_.clear();
+		removed_.clear();
+		seen_.assign(devices_.size(), false);
+
+		detail::visit_hidapi_devices(
+				[this](const detail::EnumeratedDevice& device)
+				{
+					const std::string_view path(device.path);
+					const auto known = std::ranges::find_if(
+							devices_,
+							[path](const DeviceInfo& device_info)
+							{
+								return device_info.path == path;
+							}
+					);
+
+					if(known != devices_.end())
+					{
+						seen_[static_cast<size_t>(std::distance(devices_.begin(), known))] = true;
+					}
+					else
+					{
+						added_.push_back(detail::to_device_info(device));
+					}
+				}
+		);
+
+		size_t kept = 0;
+		for(size_t i = 0; i < devices_.size(); ++i)
+		{
+			if(!seen_[i])
+			{
+				removed_.push_back(std::move(devices_[i]));
+			}
+			else
+			{
+				if(kept != i)
+				{
+					devices_[kept] = std::move(devices_[i]);
+				}
+				++kept;
+			}
+		}
+		devices_.erase(devices_.begin() + static_cast<std::ptrdiff_t>(kept), devices_.end());
+		devices_.insert(devices_.end(), added_.begin(), added_.end());
+
+		return {added_, removed_};
+	}
+
+	const std::vector<DeviceInfo>& EnumerationCache::devices() const
+	{
+		return devices_;
+	}
+}
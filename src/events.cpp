@@ -0,0 +1,97 @@
+#include "dual_sense_hid/events.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+
+namespace dual_sense_hid::detail
+{
+	namespace
+	{
+		inline int distance(uint8_t a, uint8_t b)
+		{
+			return std::abs(static_cast<int>(a) - static_cast<int>(b));
+		}
+
+		inline bool moved(const State::AnalogPad& reference, const State::AnalogPad& current, uint8_t threshold)
+		{
+			const auto delta = std::max(distance(reference.x, current.x), distance(reference.y, current.y));
+
+			return delta >= std::max<int>(threshold, 1);
+		}
+
+		inline bool moved(uint8_t reference, uint8_t current, uint8_t threshold)
+		{
+			return distance(reference, current) >= std::max<int>(threshold, 1);
+		}
+	}
+
+	void Subscription::dispatch(const State& previous, const State& current, uint32_t pressed, uint32_t released)
+	{
+		const auto wants = [this](Event::Type type)
+		{
+			return (filter.events & event_mask(type)) != 0;
+		};
+
+		if(!initialized)
+		{
+			left_pad = current.left_pad;
+			right_pad = current.right_pad;
+			left_trigger = current.left_trigger.value;
+			right_trigger = current.right_trigger.value;
+			initialized = true;
+		}
+
+		if(const auto buttons = pressed & filter.buttons; buttons != 0 && wants(Event::Type::BUTTON_PRESSED))
+		{
+			callback({Event::Type::BUTTON_PRESSED, buttons, 0}, current);
+		}
+		if(const auto buttons = released & filter.buttons; buttons != 0 && wants(Event::Type::BUTTON_RELEASED))
+		{
+			callback({Event::Type::BUTTON_RELEASED, buttons, 0}, current);
+		}
+
+		if(wants(Event::Type::LEFT_STICK_MOVED) && moved(left_pad, current.left_pad, filter.stick_threshold))
+		{
+			left_pad = current.left_pad;
+			callback({Event::Type::LEFT_STICK_MOVED, 0, 0}, current);
+		}
+		if(wants(Event::Type::RIGHT_STICK_MOVED) && moved(right_pad, current.right_pad, filter.stick_threshold))
+		{
+			right_pad = current.right_pad;
+			callback({Event::Type::RIGHT_STICK_MOVED, 0, 0}, current);
+		}
+
+		if(wants(Event::Type::LEFT_TRIGGER_CHANGED) && moved(left_trigger, current.left_trigger.value, filter.trigger_threshold))
+		{
+			left_trigger = current.left_trigger.value;
+			callback({Event::Type::LEFT_TRIGGER_CHANGED, 0, 0}, current);
+		}
+		if(wants(Event::Type::RIGHT_TRIGGER_CHANGED) && moved(right_trigger, current.right_trigger.value, filter.trigger_threshold))
+		{
+			right_trigger = current.right_trigger.value;
+			callback({Event::Type::RIGHT_TRIGGER_CHANGED, 0, 0}, current);
+		}
+
+		const bool previous_touch[2] = {previous.touch_point_0.active, previous.touch_point_1.active};
+		const bool current_touch[2] = {current.touch_point_0.active, current.touch_point_1.active};
+		for(uint8_t i = 0; i < 2; ++i)
+		{
+			if(!previous_touch[i] && current_touch[i] && wants(Event::Type::TOUCH_BEGIN))
+			{
+				callback({Event::Type::TOUCH_BEGIN, 0, i}, current);
+			}
+			if(previous_touch[i] && !current_touch[i] && wants(Event::Type::TOUCH_END))
+			{
+				callback({Event::Type::TOUCH_END, 0, i}, current);
+			}
+		}
+
+		const bool battery_changed = previous.battery.level != current.battery.level
+				|| previous.battery.power_status != current.battery.power_status;
+		if(battery_changed && wants(Event::Type::BATTERY_CHANGED))
+		{
+			callback({Event::Type::BATTERY_CHANGED, 0, 0}, current);
+		}
+	}
+}
@@ -1,43 +1,33 @@
 #include "dual_sense_hid/gamepad.hpp"
 
-#include <locale>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <limits>
 
 #include <cassert>
 #include <hidapi.h>
 
+#include "dual_sense_hid/detail/buttons.hpp"
+#include "dual_sense_hid/detail/calibration_kernel.hpp"
+#include "dual_sense_hid/detail/calibration_report.hpp"
 #include "dual_sense_hid/detail/crc32.hpp"
 #include "dual_sense_hid/detail/helper.hpp"
+#include "dual_sense_hid/detail/hidapi_enumeration.hpp"
 #include "dual_sense_hid/detail/report_input.hpp"
 #include "dual_sense_hid/detail/report_output.hpp"
+#include "dual_sense_hid/detail/timestamp.hpp"
+#include "dual_sense_hid/detail/transport.hpp"
 
-static constexpr uint8_t CALIBRATION_REPORT_ID = 0x05;
+static constexpr int READER_TIMEOUT_MS = 10;
 
 
 namespace dual_sense_hid
 {
 	namespace
 	{
-		inline State::TouchPoint extract_touch_point(const uint8_t touch_data[4])
-		{
-			const auto x = static_cast<uint16_t>(((touch_data[2] & 0x0f) << 8) | touch_data[1]);
-			const auto y = static_cast<uint16_t>((touch_data[3] << 4) | (touch_data[2] & 0xf0 >> 4));
-
-			return
-					{
-							(touch_data[0] & 0x80) == 0,
-							x, y,
-							static_cast<uint8_t>(touch_data[0] & 0x7f)
-					};
-		}
-
-		template<typename T>
-		requires std::integral<T>
-		inline T mult_frac(T value, T numerator, T denominator)
-		{
-			return (value / denominator) * numerator + ((value % denominator) * numerator) / denominator;
-		}
-
-		void push_report(const detail::SetStateReportCommon& common_report, ConnectionType connection_type, hid_device *dev)
+		bool push_report(const detail::SetStateReportCommon& common_report, ConnectionType connection_type, detail::Transport& transport)
 		{
 			if (connection_type == ConnectionType::USB)
 			{
@@ -45,7 +35,7 @@ namespace dual_sense_hid
 				report.report_id = 0x02;
 				report.common = common_report;
 
-				hid_write(dev, reinterpret_cast<uint8_t*>(&report), sizeof(detail::SetStateReportUSB));
+				return transport.write(reinterpret_cast<uint8_t*>(&report), sizeof(detail::SetStateReportUSB)) >= 0;
 			}
 			else
 			{
@@ -58,47 +48,101 @@ namespace dual_sense_hid
 				report.common = common_report;
 				report.checksum = detail::crc32(reinterpret_cast<const uint8_t*>(&report), 74);
 
-				hid_write(dev, reinterpret_cast<uint8_t*>(&report), sizeof(detail::SetStateReportBT));
+				return transport.write(reinterpret_cast<uint8_t*>(&report), sizeof(detail::SetStateReportBT)) >= 0;
 			}
 		}
-	}
 
-	std::vector<DeviceInfo> enumerate()
-	{
-		using namespace detail;
-
-		const auto enumerated_list = hid_enumerate(VENDOR_ID, PRODUCT_ID);
-
-		std::vector<DeviceInfo> devices;
+		inline const detail::ReportCommon& common_report(const uint8_t* report, ConnectionType connection_type)
+		{
+			return connection_type == ConnectionType::USB ? reinterpret_cast<const detail::ReportUSB*>(report)->common
+			                                              : reinterpret_cast<const detail::ReportBT*>(report)->common;
+		}
 
-		auto current = enumerated_list;
-		while (current)
+		template<typename Factory>
+		std::vector<OpenResult> open_concurrently(std::span<const DeviceInfo> devices, const Factory& factory)
 		{
-			const std::string path = current->path;
-			const auto serial = wstring_to_string(current->serial_number);
-			const auto manufacturer_string = wstring_to_string(current->manufacturer_string);
-			const auto product_string = wstring_to_string(current->product_string);
+			// hid_init isn't thread-safe, while hid_open_path calls it lazily
+			if(hid_init() != 0)
+			{
+				throw std::runtime_error("Failed to initialize hidapi");
+			}
 
-			const auto connection_type = current->release_number == 0 ? ConnectionType::BLUETOOTH : ConnectionType::USB;
+			std::vector<std::future<std::unique_ptr<Gamepad>>> pending;
+			pending.reserve(devices.size());
+			for(const auto& device_info: devices)
+			{
+				pending.push_back(std::async(std::launch::async, factory, std::cref(device_info)));
+			}
 
-			devices.emplace_back(path, serial, manufacturer_string, product_string, connection_type);
+			std::vector<OpenResult> results(devices.size());
+			for(size_t i = 0; i < pending.size(); ++i)
+			{
+				try
+				{
+					results[i].gamepad = pending[i].get();
+				}
+				catch(...)
+				{
+					results[i].error = std::current_exception();
+				}
+			}
 
-			current = current->next;
+			return results;
 		}
+	}
+
+	std::vector<DeviceInfo> enumerate()
+	{
+		std::vector<DeviceInfo> devices;
+
+		detail::visit_hidapi_devices(
+				[&devices](const detail::EnumeratedDevice& device)
+				{
+					devices.push_back(detail::to_device_info(device));
+				}
+		);
 
 		return devices;
 	}
 
+	std::vector<OpenResult> open_all(std::span<const DeviceInfo> devices, bool fetch_calibration_data)
+	{
+		return open_concurrently(
+				devices,
+				[fetch_calibration_data](const DeviceInfo& device_info)
+				{
+					return std::make_unique<Gamepad>(device_info, fetch_calibration_data);
+				}
+		);
+	}
+
+	std::vector<OpenResult> open_all(std::span<const DeviceInfo> devices, const CalibrationCache& calibration_cache)
+	{
+		return open_concurrently(
+				devices,
+				[&calibration_cache](const DeviceInfo& device_info)
+				{
+					return std::make_unique<Gamepad>(device_info, calibration_cache);
+				}
+		);
+	}
+
 	void Gamepad::Lights::set_player_indicator(Gamepad::Lights::PlayerIndicator indicator)
 	{
-		changed_ |= indicator != player_indicator_;
+		if(indicator != player_indicator_)
+		{
+			dirty_ |= PLAYER_INDICATORS_SECTION;
+		}
 
 		player_indicator_ = indicator;
 	}
 
 	void Gamepad::Lights::set_touchpad_light_color(uint8_t red, uint8_t green, uint8_t blue)
 	{
-		changed_ |= (red != touchpad_light_red_) || (green != touchpad_light_green_) || (blue != touchpad_light_blue_);
+		if((red != touchpad_light_red_) || (green != touchpad_light_green_) || (blue != touchpad_light_blue_))
+		{
+			dirty_ |= LED_COLOR_SECTION;
+		}
 
 		touchpad_light_red_ = red;
 		touchpad_light_green_ = green;
@@ -107,21 +151,31 @@ namespace dual_sense_hid
 
 	void Gamepad::Lights::set_player_indicator_brightness(Gamepad::Lights::PlayerIndicatorBrightness brightness)
 	{
-		changed_ |= player_indicator_brightness_ != brightness;
+		if(player_indicator_brightness_ != brightness)
+		{
+			dirty_ |= BRIGHTNESS_SECTION;
+		}
 
 		player_indicator_brightness_ = brightness;
 	}
 
 	void Gamepad::Lights::set_mute_light_mode(MuteLightMode mute_light_mode)
 	{
-		changed_ |= mute_light_mode_ != mute_light_mode;
+		if(mute_light_mode_ != mute_light_mode)
+		{
+			dirty_ |= MUTE_LIGHT_SECTION;
+		}
 
 		mute_light_mode_ = mute_light_mode;
 	}
 
 	void Gamepad::Lights::enable_player_indicator_fade(bool enabled)
 	{
-		changed_ |= enabled != player_indicator_fade_enabled_;
+		// fade flag is carried in player indicators section
+		if(enabled != player_indicator_fade_enabled_)
+		{
+			dirty_ |= PLAYER_INDICATORS_SECTION;
+		}
 
 		player_indicator_fade_enabled_ = enabled;
 	}
@@ -129,12 +183,7 @@ namespace dual_sense_hid
 	Gamepad::Gamepad(const DeviceInfo &device_info, bool fetch_calibration_data)
 		:connection_type_(device_info.connection_type)
 	{
-		const auto &path = device_info.path;
-		device_ = hid_open_path(path.c_str());
-		if (device_ == nullptr)
-		{
-			throw std::runtime_error("Failed to open device path");
-		}
+		transport_ = detail::open_transport(device_info.path, device_info.backend);
 
 		if(fetch_calibration_data)
 		{
@@ -144,45 +193,534 @@ namespace dual_sense_hid
 		take_lights_control();
 	}
 
+	Gamepad::Gamepad(const DeviceInfo& device_info, const CalibrationCache& calibration_cache)
+		:Gamepad(device_info, false)
+	{
+		if(const auto cached = calibration_cache.load(device_info.serial))
+		{
+			set_calibration_data(*cached);
+		}
+		else
+		{
+			calibration_cache.store(device_info.serial, get_calibration_data());
+		}
+	}
+
+	Gamepad::~Gamepad()
+	{
+		stop_reader();
+		stop_async_output();
+	}
+
 	State Gamepad::poll(bool use_calibration_data) const
 	{
-		using namespace detail;
+		ensure_reader_stopped();
+
+		uint8_t report[78];
+		while(!read_report(report, -1))
+		{}
+
+		return process_report(common_report(report, connection_type_), use_calibration_data);
+	}
+
+	std::optional<State> Gamepad::try_poll(bool use_calibration_data) const
+	{
+		ensure_reader_stopped();
+
+		uint8_t report[78];
+		if(!read_report(report, 0))
+		{
+			return std::nullopt;
+		}
+
+		return process_report(common_report(report, connection_type_), use_calibration_data);
+	}
+
+	std::optional<State> Gamepad::poll_for(std::chrono::microseconds timeout, bool use_calibration_data) const
+	{
+		ensure_reader_stopped();
+
+		const auto timeout_ms = std::clamp<std::chrono::milliseconds::rep>(
+				std::chrono::ceil<std::chrono::milliseconds>(timeout).count(),
+				0,
+				std::numeric_limits<int>::max()
+		);
+
+		uint8_t report[78];
+		if(!read_report(report, static_cast<int>(timeout_ms)))
+		{
+			return std::nullopt;
+		}
+
+		return process_report(common_report(report, connection_type_), use_calibration_data);
+	}
+
+	std::optional<State> Gamepad::poll_latest(bool use_calibration_data) const
+	{
+		ensure_reader_stopped();
+
+		uint8_t reports[2][78];
+		size_t latest = 0;
+
+		if(!read_report(reports[latest], 0))
+		{
+			return std::nullopt;
+		}
+
+		while(read_report(reports[latest ^ 1], 0))
+		{
+			latest ^= 1;
+		}
+
+		return process_report(common_report(reports[latest], connection_type_), use_calibration_data);
+	}
+
+	std::size_t Gamepad::poll_batch(std::span<State> out, bool use_calibration_data) const
+	{
+		ensure_reader_stopped();
+
+		if(use_calibration_data && !calibration_data_loaded_)
+		{
+			get_calibration_data();
+		}
+
+		uint8_t report[78];
+		const auto& common = common_report(report, connection_type_);
+
+		std::size_t count = 0;
+		while(count < out.size() && read_report(report, 0))
+		{
+			out[count++] = process_report(common, use_calibration_data);
+		}
+
+		return count;
+	}
+
+	void Gamepad::poll_raw(RawReport& report) const
+	{
+		ensure_reader_stopped();
+
+		report.connection_type_ = connection_type_;
+		while(!read_report(report.data_.data(), -1))
+		{}
+		report.host_timestamp_ = detail::host_timestamp();
+	}
+
+	bool Gamepad::try_poll_raw(RawReport& report) const
+	{
+		ensure_reader_stopped();
+
+		report.connection_type_ = connection_type_;
+		if(!read_report(report.data_.data(), 0))
+		{
+			return false;
+		}
+
+		report.host_timestamp_ = detail::host_timestamp();
+		return true;
+	}
+
+	State Gamepad::decode(const RawReport& report, bool use_calibration_data) const
+	{
+		return decode_report(report.common(), use_calibration_data, report.host_timestamp_);
+	}
+
+	void Gamepad::start_reader(bool use_calibration_data)
+	{
+		if(reader_running_.load(std::memory_order_acquire))
+		{
+			return;
+		}
+		stop_reader();
+
+		if(use_calibration_data && !calibration_data_loaded_)
+		{
+			get_calibration_data();
+		}
+
+		if(!reader_queue_)
+		{
+			reader_queue_ = std::make_unique<detail::SpscRing<State, READER_QUEUE_CAPACITY>>();
+		}
+
+		reader_running_.store(true, std::memory_order_release);
+		reader_thread_ = std::jthread(
+				[this, use_calibration_data](const std::stop_token& stop_token)
+				{
+					reader_loop(stop_token, use_calibration_data);
+				}
+		);
+	}
+
+	void Gamepad::stop_reader()
+	{
+		if(reader_thread_.joinable())
+		{
+			reader_thread_.request_stop();
+			reader_thread_.join();
+		}
+	}
+
+	bool Gamepad::is_reader_running() const
+	{
+		return reader_running_.load(std::memory_order_acquire);
+	}
+
+	std::optional<State> Gamepad::pop_state()
+	{
+		State state;
+		if(!reader_queue_ || !reader_queue_->try_pop(state))
+		{
+			return std::nullopt;
+		}
+
+		return state;
+	}
+
+	std::size_t Gamepad::dropped_reports() const
+	{
+		return dropped_reports_.load(std::memory_order_relaxed);
+	}
 
-		uint8_t report[78] = {};
+	void Gamepad::ensure_reader_stopped() const
+	{
+		if(reader_thread_.joinable())
+		{
+			throw std::logic_error("Gamepad can't be polled while reader thread is active");
+		}
+	}
+
+	void Gamepad::reader_loop(const std::stop_token& stop_token, bool use_calibration_data)
+	{
+		uint8_t report[78];
+
+		while(!stop_token.stop_requested())
+		{
+			try
+			{
+				if(!read_report(report, READER_TIMEOUT_MS))
+				{
+					continue;
+				}
+			}
+			catch(const std::runtime_error&)
+			{
+				// device disconnected or failed, reader stops
+				break;
+			}
+
+			// exceptions of subscribers and resumed coroutines have no caller to reach, they are discarded
+			std::exception_ptr listener_error;
+			const auto state = process_report(common_report(report, connection_type_), use_calibration_data, listener_error);
+			if(!reader_queue_->try_push(state))
+			{
+				dropped_reports_.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		reader_running_.store(false, std::memory_order_release);
+	}
+
+	void Gamepad::writer_loop(const std::stop_token& stop_token)
+	{
+		auto& mailbox = *output_mailbox_;
+		const std::stop_callback close_mailbox(
+				stop_token,
+				[&mailbox]()
+				{
+					mailbox.close();
+				}
+		);
+
+		while(const auto* report = mailbox.wait_take())
+		{
+			push_report(*report, connection_type_, *transport_);
+		}
+	}
+
+	bool Gamepad::read_report(uint8_t* report, int timeout_ms) const
+	{
 		const size_t to_read =
 				connection_type_ == ConnectionType::USB ? sizeof(detail::ReportUSB) : sizeof(detail::ReportBT);
-		hid_read(device_, reinterpret_cast<unsigned char *>(&report), to_read);
 
-		const auto &common =
-				connection_type_ == ConnectionType::USB ? reinterpret_cast<detail::ReportUSB *>(report)->common
-				                                        : reinterpret_cast<detail::ReportBT *>(report)->common;
+		while(true)
+		{
+			const auto result = transport_->read(report, to_read, timeout_ms);
+			if(result < 0)
+			{
+				throw std::runtime_error("Failed to read report from device");
+			}
+			if(result == 0)
+			{
+				return false;
+			}
+
+			// reduced reports (e.g. Bluetooth before full mode is enabled) are skipped
+			if(static_cast<size_t>(result) >= to_read)
+			{
+				return true;
+			}
+		}
+	}
+
+	std::optional<State> Gamepad::latest_state() const
+	{
+		State state;
+		if(!latest_state_.load(state))
+		{
+			return std::nullopt;
+		}
+
+		return state;
+	}
+
+	const InputEdges& Gamepad::edges() const
+	{
+		return edges_;
+	}
+
+	void Gamepad::enable_gyro_bias_tracking(const GyroBiasConfig& config)
+	{
+		ensure_reader_stopped();
 
-		auto gyro_pitch = static_cast<int32_t>(std::bit_cast<int16_t>(le_to_native(common.gyro_pitch)));
-		auto gyro_yaw = static_cast<int32_t>(std::bit_cast<int16_t>(le_to_native(common.gyro_yaw)));
-		auto gyro_roll = static_cast<int32_t>(std::bit_cast<int16_t>(le_to_native(common.gyro_roll)));
+		gyro_bias_estimator_.emplace(config);
+		gyro_bias_.store(gyro_bias_estimator_->bias());
+	}
 
-		auto accel_x = static_cast<int32_t>(std::bit_cast<int16_t>(le_to_native(common.acceleration_x)));
-		auto accel_y = static_cast<int32_t>(std::bit_cast<int16_t>(le_to_native(common.acceleration_y)));
-		auto accel_z = static_cast<int32_t>(std::bit_cast<int16_t>(le_to_native(common.acceleration_z)));
+	void Gamepad::disable_gyro_bias_tracking()
+	{
+		ensure_reader_stopped();
 
-		if(use_calibration_data)
+		gyro_bias_estimator_.reset();
+	}
+
+	std::optional<GyroBias> Gamepad::gyro_bias() const
+	{
+		GyroBias bias;
+		if(!gyro_bias_estimator_ || !gyro_bias_.load(bias))
 		{
-			if(!calibration_data_loaded_)
+			return std::nullopt;
+		}
+
+		return bias;
+	}
+
+	void Gamepad::enable_orientation(float beta)
+	{
+		ensure_reader_stopped();
+
+		orientation_filter_.emplace(beta);
+		orientation_.store(orientation_filter_->orientation());
+	}
+
+	void Gamepad::disable_orientation()
+	{
+		ensure_reader_stopped();
+
+		orientation_filter_.reset();
+	}
+
+	std::optional<Quaternion> Gamepad::orientation() const
+	{
+		Quaternion orientation;
+		if(!orientation_filter_ || !orientation_.load(orientation))
+		{
+			return std::nullopt;
+		}
+
+		return orientation;
+	}
+
+	SubscriptionId Gamepad::subscribe(EventCallback callback, const EventFilter& filter)
+	{
+		const std::lock_guard lock(listeners_mutex_);
+
+		const auto id = next_subscription_id_++;
+		subscriptions_.push_back({id, filter, std::move(callback)});
+		listener_count_.fetch_add(1, std::memory_order_release);
+
+		return id;
+	}
+
+	void Gamepad::unsubscribe(SubscriptionId id)
+	{
+		const std::lock_guard lock(listeners_mutex_);
+
+		const auto removed = std::erase_if(
+				subscriptions_,
+				[id](const detail::Subscription& subscription)
+				{
+					return subscription.id == id;
+				}
+		);
+		listener_count_.fetch_sub(removed, std::memory_order_release);
+	}
+
+	StateAwaitable Gamepad::next_state(Executor executor)
+	{
+		return {*this, 0, true, std::move(executor)};
+	}
+
+	StateAwaitable Gamepad::next_change(uint32_t buttons, Executor executor)
+	{
+		return {*this, buttons, false, std::move(executor)};
+	}
+
+	void Gamepad::add_waiter(detail::StateWaiter waiter)
+	{
+		const std::lock_guard lock(listeners_mutex_);
+
+		waiters_.push_back(std::move(waiter));
+		listener_count_.fetch_add(1, std::memory_order_release);
+	}
+
+	StateAwaitable::StateAwaitable(Gamepad& gamepad, uint32_t buttons, bool any_report, Executor executor)
+		:gamepad_(gamepad), buttons_(buttons), any_report_(any_report), executor_(std::move(executor))
+	{}
+
+	void StateAwaitable::await_suspend(std::coroutine_handle<> handle)
+	{
+		gamepad_.add_waiter({buttons_, any_report_, handle, std::move(executor_), &state_});
+	}
+
+	State Gamepad::process_report(const detail::ReportCommon& common, bool use_calibration_data) const
+	{
+		std::exception_ptr listener_error;
+		const auto state = process_report(common, use_calibration_data, listener_error);
+		if(listener_error)
+		{
+			std::rethrow_exception(listener_error);
+		}
+
+		return state;
+	}
+
+	State Gamepad::process_report(const detail::ReportCommon& common, bool use_calibration_data, std::exception_ptr& listener_error) const
+	{
+		// every listener is notified even if some throw, first exception is kept for caller
+		const auto contain = [&listener_error](const auto& notify)
+		{
+			try
 			{
-				get_calibration_data();
+				notify();
 			}
+			catch(...)
+			{
+				if(!listener_error)
+				{
+					listener_error = std::current_exception();
+				}
+			}
+		};
+
+		auto state = decode_report(common, use_calibration_data, detail::host_timestamp());
+
+		if(gyro_bias_estimator_ && use_calibration_data)
+		{
+			gyro_bias_estimator_->update(state.gyro, state.acceleration);
+			gyro_bias_estimator_->correct(state.gyro);
+			gyro_bias_.store(gyro_bias_estimator_->bias());
+		}
+
+		latest_state_.store(state);
+
+		if(orientation_filter_ && use_calibration_data)
+		{
+			orientation_filter_->update(state);
+			orientation_.store(orientation_filter_->orientation());
+		}
+
+		edges_.update(detail::button_mask(common.buttons), state.timestamps.host);
+
+		// resumed coroutines may poll this gamepad again, which re-enters here
+		std::vector<detail::StateWaiter> ready_waiters;
+
+		// most gamepads have no listeners, don't take lock for every report then
+		if(listener_count_.load(std::memory_order_acquire) != 0)
+		{
+			const std::lock_guard lock(listeners_mutex_);
+
+			const auto& previous = previous_state_.value_or(state);
+			for(auto& subscription: subscriptions_)
+			{
+				contain(
+						[&]()
+						{
+							subscription.dispatch(previous, state, edges_.pressed_mask(), edges_.released_mask());
+						}
+				);
+			}
+
+			const auto changed = edges_.pressed_mask() | edges_.released_mask();
+			std::erase_if(
+					waiters_,
+					[&ready_waiters, changed](detail::StateWaiter& waiter)
+					{
+						if(!waiter.any_report && (waiter.buttons & changed) == 0)
+						{
+							return false;
+						}
+
+						ready_waiters.push_back(std::move(waiter));
+						return true;
+					}
+			);
+			listener_count_.fetch_sub(ready_waiters.size(), std::memory_order_release);
+		}
+		previous_state_ = state;
+
+		for(auto& waiter: ready_waiters)
+		{
+			*waiter.result = state;
+			contain(
+					[&waiter]()
+					{
+						if(waiter.executor)
+						{
+							waiter.executor(waiter.handle);
+						}
+						else
+						{
+							waiter.handle.resume();
+						}
+					}
+			);
+		}
+
+		return state;
+	}
+
+	State Gamepad::process_raw_report(const uint8_t* report, bool use_calibration_data) const
+	{
+		return process_report(common_report(report, connection_type_), use_calibration_data);
+	}
 
-			const auto& gyro_calib = calibration_data_.gyroscope;
+	State Gamepad::decode_report(const detail::ReportCommon& common, bool use_calibration_data, uint64_t host_timestamp) const
+	{
+		using namespace detail;
 
-			gyro_pitch = mult_frac(gyro_pitch - gyro_calib.pitch_offset, gyro_calib.factor_numerator, gyro_calib.pitch_factor_denominator);
-			gyro_yaw = mult_frac(gyro_yaw - gyro_calib.yaw_offset, gyro_calib.factor_numerator, gyro_calib.yaw_factor_denominator);
-			gyro_roll = mult_frac(gyro_roll - gyro_calib.roll_offset, gyro_calib.factor_numerator, gyro_calib.roll_factor_denominator);
+		const auto sensor_ticks = sensor_clock_.extend(extract_uint32(common.sensor_timestamp));
 
-			const auto& accel_calib = calibration_data_.accelerometer;
+		// gyroscope pitch, yaw, roll and accelerometer x, y, z in kernel lanes
+		std::array<int32_t, CalibrationKernel::LANES> motion = {
+				extract_axis(common.gyro_pitch),
+				extract_axis(common.gyro_yaw),
+				extract_axis(common.gyro_roll),
+				extract_axis(common.acceleration_x),
+				extract_axis(common.acceleration_y),
+				extract_axis(common.acceleration_z),
+				0,
+				0
+		};
 
-			accel_x = mult_frac(accel_x - accel_calib.x_offset, accel_calib.factor_numerator, accel_calib.x_factor_denominator);
-			accel_y = mult_frac(accel_y - accel_calib.y_offset, accel_calib.factor_numerator, accel_calib.y_factor_denominator);
-			accel_z = mult_frac(accel_z - accel_calib.z_offset, accel_calib.factor_numerator, accel_calib.z_factor_denominator);
+		if(use_calibration_data)
+		{
+			if(!calibration_data_loaded_)
+			{
+				get_calibration_data();
+			}
+
+			motion = calibration_kernel_.apply(motion);
 		}
 
 		return
@@ -218,14 +756,14 @@ namespace dual_sense_hid
 							static_cast<bool>(common.buttons.mute)
 					},
 					{
-							gyro_pitch,
-							gyro_yaw,
-							gyro_roll
+							motion[0],
+							motion[1],
+							motion[2]
 					},
 					{
-							accel_x,
-							accel_y,
-							accel_z
+							motion[3],
+							motion[4],
+							motion[5]
 					},
 					common.temperature,
 					extract_touch_point(common.touch_data_0),
@@ -238,106 +776,117 @@ namespace dual_sense_hid
 						static_cast<bool>(common.muted),
 						static_cast<bool>(common.headphones),
 						static_cast<bool>(common.microphone)
+					},
+					{
+						sensor_ticks / SENSOR_TICKS_PER_US,
+						host_timestamp,
+						common.touch_timestamp
 					}
 			};
 	}
 
 	const Calibration& Gamepad::get_calibration_data() const
 	{
-		using namespace detail;
 		if(!calibration_data_loaded_)
 		{
-			uint8_t report_raw[37];
-			report_raw[0] = CALIBRATION_REPORT_ID;
-
-			hid_get_feature_report(device_, report_raw, sizeof(report_raw));
-
-			const auto data_raw = reinterpret_cast<detail::CalibrationReport*>(report_raw);
+			set_calibration_data(detail::fetch_calibration(*transport_));
+		}
 
-			auto& gyro_calibration = calibration_data_.gyroscope;
-			auto& accel_calibration = calibration_data_.accelerometer;
+		return calibration_data_;
+	}
 
-			gyro_calibration.pitch_offset = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_pitch_bias));
-			gyro_calibration.yaw_offset = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_yaw_bias));
-			gyro_calibration.roll_offset = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_roll_bias));
+	void Gamepad::set_calibration_data(const Calibration& calibration) const
+	{
+		calibration_data_ = calibration;
+		calibration_kernel_ = detail::CalibrationKernel::from_calibration(calibration_data_);
+		calibration_data_loaded_ = true;
+	}
+	
+	bool Gamepad::push_state(bool full_update)
+	{
+		auto sections = full_update ? static_cast<uint8_t>(Lights::ALL_SECTIONS | Lights::COLOR_FADE_SECTION) : lights_.dirty_;
 
+		if(writer_thread_.joinable())
+		{
+			// snapshot not taken by writer yet gets replaced, so its sections have to be sent again
+			if(output_mailbox_->pending())
 			{
-				const auto gyro_speed_plus = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_speed_plus));
-				const auto gyro_speed_minus = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_speed_minus));
-
-				const auto gyro_speed = gyro_speed_plus + gyro_speed_minus;
-
-				gyro_calibration.factor_numerator = gyro_speed * Calibration::GYROSCOPE_RESOLUTION;
+				sections |= unsent_sections_;
 			}
+			if(sections == 0)
 			{
-				const auto gyro_pitch_plus = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_pitch_plus));
-				const auto gyro_pitch_minus = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_pitch_minus));
-
-				gyro_calibration.pitch_factor_denominator = gyro_pitch_plus - gyro_pitch_minus;
+				return false;
 			}
-			{
-				const auto gyro_yaw_plus = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_yaw_plus));
-				const auto gyro_yaw_minus = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_yaw_minus));
 
-				gyro_calibration.yaw_factor_denominator = gyro_yaw_plus - gyro_yaw_minus;
-			}
-			{
-				const auto gyro_roll_plus = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_roll_plus));
-				const auto gyro_roll_minus = std::bit_cast<int16_t>(le_to_native(data_raw->gyro_roll_minus));
+			output_mailbox_->back() = build_output_report(sections);
+			output_mailbox_->publish();
 
-				gyro_calibration.roll_factor_denominator = gyro_roll_plus - gyro_roll_minus;
-			}
+			unsent_sections_ = sections;
+			lights_.dirty_ = 0;
 
-			accel_calibration.factor_numerator = 2 * Calibration::ACCELEROMETER_RESOLUTION;
-			{
-				const auto accel_x_plus = std::bit_cast<int16_t>(le_to_native(data_raw->accel_x_plus));
-				const auto accel_x_minus = std::bit_cast<int16_t>(le_to_native(data_raw->accel_x_minus));
+			return true;
+		}
 
-				const auto accel_range = accel_x_plus - accel_x_minus;
+		if(sections == 0 || !push_report(build_output_report(sections), connection_type_, *transport_))
+		{
+			return false;
+		}
 
-				accel_calibration.x_offset = accel_x_plus - accel_range/2;
-				accel_calibration.x_factor_denominator = accel_range;
-			}
-			{
-				const auto accel_y_plus = std::bit_cast<int16_t>(le_to_native(data_raw->accel_y_plus));
-				const auto accel_y_minus = std::bit_cast<int16_t>(le_to_native(data_raw->accel_y_minus));
+		lights_.dirty_ = 0;
 
-				const auto accel_range = accel_y_plus - accel_y_minus;
+		return true;
+	}
 
-				accel_calibration.y_offset = accel_y_plus - accel_range/2;
-				accel_calibration.y_factor_denominator = accel_range;
-			}
-			{
-				const auto accel_z_plus = std::bit_cast<int16_t>(le_to_native(data_raw->accel_z_plus));
-				const auto accel_z_minus = std::bit_cast<int16_t>(le_to_native(data_raw->accel_z_minus));
+	void Gamepad::start_async_output()
+	{
+		if(writer_thread_.joinable())
+		{
+			return;
+		}
 
-				const auto accel_range = accel_z_plus - accel_z_minus;
+		output_mailbox_ = std::make_unique<detail::TripleBuffer<detail::SetStateReportCommon>>();
+		unsent_sections_ = 0;
 
-				accel_calibration.z_offset = accel_z_plus - accel_range/2;
-				accel_calibration.z_factor_denominator = accel_range;
-			}
+		writer_thread_ = std::jthread(
+				[this](const std::stop_token& stop_token)
+				{
+					writer_loop(stop_token);
+				}
+		);
+	}
 
-			calibration_data_loaded_ = true;
+	void Gamepad::stop_async_output()
+	{
+		if(writer_thread_.joinable())
+		{
+			writer_thread_.request_stop();
+			writer_thread_.join();
 		}
 
-		return calibration_data_;
+		output_mailbox_.reset();
 	}
-	
-	void Gamepad::push_state(bool full_update)
+
+	bool Gamepad::is_async_output_running() const
+	{
+		return writer_thread_.joinable();
+	}
+
+	detail::SetStateReportCommon Gamepad::build_output_report(uint8_t sections) const
 	{
 		detail::SetStateReportCommon common_report{};
 
-		if(full_update || lights_.changed_)
+		if((sections & Lights::LED_COLOR_SECTION) != 0)
 		{
 			common_report.enable_led_color_section = true;
-			common_report.enable_player_indicators_section = true;
-			common_report.enable_light_brightness_section = true;
-			common_report.enable_color_light_fade_section = true;
-			common_report.enable_mute_light_section = true;
 
-			common_report.power_save_mute.mute_light_mode = static_cast<uint8_t>(lights_.mute_light_mode_);
+			common_report.touchpad_led_color.red_led = lights_.touchpad_light_red_;
+			common_report.touchpad_led_color.green_led = lights_.touchpad_light_green_;
+			common_report.touchpad_led_color.blue_led = lights_.touchpad_light_blue_;
+		}
 
-			common_report.player_led.brightness = static_cast<uint8_t>(lights_.player_indicator_brightness_);
+		if((sections & Lights::PLAYER_INDICATORS_SECTION) != 0)
+		{
+			common_report.enable_player_indicators_section = true;
 
 			common_report.player_led.led_1 = false;
 			common_report.player_led.led_2 = false;
@@ -375,13 +924,35 @@ namespace dual_sense_hid
 			}
 
 			common_report.player_led.led_fade = !lights_.player_indicator_fade_enabled_;
+		}
 
-			common_report.touchpad_led_color.red_led = lights_.touchpad_light_red_;
-			common_report.touchpad_led_color.green_led = lights_.touchpad_light_green_;
-			common_report.touchpad_led_color.blue_led = lights_.touchpad_light_blue_;
+		if((sections & Lights::BRIGHTNESS_SECTION) != 0)
+		{
+			common_report.enable_light_brightness_section = true;
+
+			common_report.player_led.brightness = static_cast<uint8_t>(lights_.player_indicator_brightness_);
+		}
+
+		if((sections & Lights::MUTE_LIGHT_SECTION) != 0)
+		{
+			common_report.enable_mute_light_section = true;
+
+			common_report.power_save_mute.mute_light_mode = static_cast<uint8_t>(lights_.mute_light_mode_);
 		}
 
-		push_report(common_report, connection_type_, device_);
+		common_report.enable_color_light_fade_section = (sections & Lights::COLOR_FADE_SECTION) != 0;
+
+		return common_report;
+	}
+
+	int Gamepad::native_handle() const
+	{
+		return transport_->native_handle();
+	}
+
+	ConnectionType Gamepad::connection_type() const
+	{
+		return connection_type_;
 	}
 
 	Gamepad::Lights& Gamepad::lights()
@@ -394,6 +965,6 @@ namespace dual_sense_hid
 		detail::SetStateReportCommon common_report{};
 		common_report.reset_lights = true;
 
-		push_report(common_report, connection_type_, device_);
+		push_report(common_report, connection_type_, *transport_);
 	}
 }
\ No newline at end of file
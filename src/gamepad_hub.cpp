@@ -0,0 +1,159 @@
+#include "dual_sense_hid/gamepad_hub.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include "dual_sense_hid/detail/report_input.hpp"
+
+static constexpr int RUN_TIMEOUT_MS = 100;
+
+
+namespace dual_sense_hid
+{
+	GamepadHub::GamepadHub(Callback callback, DisconnectCallback disconnect_callback)
+		:epoll_fd_(epoll_create1(EPOLL_CLOEXEC)), callback_(std::move(callback)), disconnect_callback_(std::move(disconnect_callback))
+	{
+		if(epoll_fd_ < 0)
+		{
+			throw std::runtime_error("Failed to create epoll instance");
+		}
+	}
+
+	GamepadHub::~GamepadHub()
+	{
+		::close(epoll_fd_);
+	}
+
+	void GamepadHub::add(Gamepad& gamepad, bool use_calibration_data)
+	{
+		const auto fd = gamepad.native_handle();
+		if(fd < 0)
+		{
+			throw std::invalid_argument("Gamepad doesn't expose pollable handle (hidraw backend required)");
+		}
+		if(gamepad.is_reader_running())
+		{
+			throw std::logic_error("Gamepad with running reader thread can't be added to hub");
+		}
+
+		if(use_calibration_data)
+		{
+			gamepad.get_calibration_data();
+		}
+
+		auto entry = std::make_unique<Entry>(&gamepad, use_calibration_data);
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.ptr = entry.get();
+		if(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0)
+		{
+			throw std::runtime_error("Failed to register gamepad in epoll");
+		}
+
+		entries_.push_back(std::move(entry));
+	}
+
+	void GamepadHub::remove(Gamepad& gamepad)
+	{
+		epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, gamepad.native_handle(), nullptr);
+
+		std::erase_if(
+				entries_,
+				[&gamepad](const std::unique_ptr<Entry>& entry)
+				{
+					return entry->gamepad == &gamepad;
+				}
+		);
+	}
+
+	std::size_t GamepadHub::run_once(std::chrono::milliseconds timeout)
+	{
+		const auto timeout_ms = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(
+				timeout.count(),
+				-1,
+				std::numeric_limits<int>::max()
+		));
+		const auto ready = epoll_wait(epoll_fd_, events_.data(), static_cast<int>(events_.size()), timeout_ms);
+		if(ready <= 0)
+		{
+			return 0;
+		}
+
+		std::size_t dispatched = 0;
+		std::vector<Entry*> failed;
+		std::array<uint8_t, sizeof(detail::ReportBT)> report{};
+
+		for(size_t i = 0; i < static_cast<size_t>(ready); ++i)
+		{
+			auto& entry = *static_cast<Entry*>(events_[i].data.ptr);
+
+			// only failed read means failed gamepad, processing runs subscriber callbacks
+			bool has_report;
+			try
+			{
+				has_report = entry.gamepad->read_report(report.data(), 0);
+			}
+			catch(const std::runtime_error&)
+			{
+				failed.push_back(&entry);
+				continue;
+			}
+
+			// exceptions of subscribers and user callback propagate, gamepad isn't considered failed
+			if(has_report)
+			{
+				try
+				{
+					const auto state = entry.gamepad->process_raw_report(report.data(), entry.use_calibration_data);
+					callback_(*entry.gamepad, state);
+				}
+				catch(...)
+				{
+					drop_all(failed);
+					throw;
+				}
+				++dispatched;
+			}
+			else if((events_[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+			{
+				failed.push_back(&entry);
+			}
+		}
+
+		drop_all(failed);
+
+		return dispatched;
+	}
+
+	void GamepadHub::run(const std::stop_token& stop_token)
+	{
+		while(!stop_token.stop_requested())
+		{
+			run_once(std::chrono::milliseconds(RUN_TIMEOUT_MS));
+		}
+	}
+
+	void GamepadHub::drop_all(const std::vector<Entry*>& entries)
+	{
+		for(auto* entry: entries)
+		{
+			drop(*entry);
+		}
+	}
+
+	void GamepadHub::drop(Entry& entry)
+	{
+		auto& gamepad = *entry.gamepad;
+		remove(gamepad);
+
+		if(disconnect_callback_)
+		{
+			disconnect_callback_(gamepad);
+		}
+	}
+}
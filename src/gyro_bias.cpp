@@ -0,0 +1,104 @@
+#include "dual_sense_hid/gyro_bias.hpp"
+
+#include <cstdlib>
+
+
+namespace dual_sense_hid
+{
+	namespace
+	{
+		constexpr auto WINDOW = static_cast<int64_t>(GyroBiasEstimator::WINDOW_SIZE);
+
+		/**
+		 * @brief Compare variance with threshold without division: n*sum(x^2) - sum(x)^2 < (threshold*n)^2
+		 */
+		inline bool below_threshold(int64_t sum, int64_t squares, int32_t threshold)
+		{
+			const auto scaled_variance = WINDOW * squares - sum * sum;
+			const auto limit = static_cast<int64_t>(threshold) * WINDOW;
+
+			return scaled_variance < limit * limit;
+		}
+
+		inline int32_t mean(int64_t sum)
+		{
+			return static_cast<int32_t>((sum + (sum >= 0 ? WINDOW / 2 : -WINDOW / 2)) / WINDOW);
+		}
+	}
+
+	GyroBiasEstimator::GyroBiasEstimator(const GyroBiasConfig& config)
+		:config_(config)
+	{}
+
+	void GyroBiasEstimator::update(const State::Gyro& gyro, const State::Acceleration& acceleration)
+	{
+		const std::array<int32_t, AXES> sample = {gyro.pitch, gyro.yaw, gyro.roll, acceleration.x, acceleration.y, acceleration.z};
+
+		auto& slot = window_[next_];
+		for(size_t axis = 0; axis < AXES; ++axis)
+		{
+			if(count_ == WINDOW_SIZE)
+			{
+				const int64_t evicted = slot[axis];
+				sums_[axis] -= evicted;
+				squares_[axis] -= evicted * evicted;
+			}
+
+			const int64_t value = sample[axis];
+			sums_[axis] += value;
+			squares_[axis] += value * value;
+		}
+		slot = sample;
+
+		next_ = (next_ + 1) % WINDOW_SIZE;
+		if(count_ < WINDOW_SIZE)
+		{
+			++count_;
+		}
+		if(count_ < WINDOW_SIZE)
+		{
+			bias_.still = false;
+			return;
+		}
+
+		bool still = true;
+		for(size_t axis = 0; axis < AXES; ++axis)
+		{
+			const auto threshold = axis < 3 ? config_.gyro_threshold : config_.acceleration_threshold;
+			still = still && below_threshold(sums_[axis], squares_[axis], threshold);
+		}
+
+		const std::array<int32_t, 3> gyro_mean = {mean(sums_[0]), mean(sums_[1]), mean(sums_[2])};
+		for(const auto axis_mean: gyro_mean)
+		{
+			still = still && std::abs(axis_mean) <= config_.max_bias;
+		}
+
+		bias_.still = still;
+		if(still)
+		{
+			bias_.bias = {gyro_mean[0], gyro_mean[1], gyro_mean[2]};
+		}
+	}
+
+	void GyroBiasEstimator::correct(State::Gyro& gyro) const
+	{
+		gyro.pitch -= bias_.bias.pitch;
+		gyro.yaw -= bias_.bias.yaw;
+		gyro.roll -= bias_.bias.roll;
+	}
+
+	GyroBias GyroBiasEstimator::bias() const
+	{
+		return bias_;
+	}
+
+	void GyroBiasEstimator::reset()
+	{
+		next_ = 0;
+		count_ = 0;
+		sums_ = {};
+		squares_ = {};
+		bias_ = {};
+	}
+}
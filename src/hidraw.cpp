@@ -0,0 +1,111 @@
+#include "dual_sense_hid/hidraw.hpp"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "dual_sense_hid/gamepad.hpp"
+#include "dual_sense_hid/detail/hidraw.hpp"
+
+static constexpr unsigned long BUS_USB = 0x03;
+static constexpr unsigned long BUS_BLUETOOTH = 0x05;
+
+
+namespace dual_sense_hid
+{
+	namespace
+	{
+		unsigned long parse_hex(std::string_view value)
+		{
+			unsigned long result = 0;
+			std::from_chars(value.data(), value.data() + value.size(), result, 16);
+
+			return result;
+		}
+	}
+
+	std::optional<DeviceInfo> detail::read_hidraw_device_info(std::string_view node_name)
+	{
+		const auto uevent_path = std::filesystem::path("/sys/class/hidraw") / node_name / "device" / "uevent";
+
+		std::ifstream uevent(uevent_path);
+		if(!uevent)
+		{
+			return std::nullopt;
+		}
+
+		std::string hid_id;
+		std::string hid_name;
+		std::string hid_uniq;
+
+		std::string line;
+		while(std::getline(uevent, line))
+		{
+			const auto separator = line.find('=');
+			if(separator == std::string::npos)
+			{
+				continue;
+			}
+
+			const auto key = std::string_view(line).substr(0, separator);
+			auto value = line.substr(separator + 1);
+
+			if(key == "HID_ID")
+			{
+				hid_id = std::move(value);
+			}
+			else if(key == "HID_NAME")
+			{
+				hid_name = std::move(value);
+			}
+			else if(key == "HID_UNIQ")
+			{
+				hid_uniq = std::move(value);
+			}
+		}
+
+		// HID_ID=<bus>:<vendor>:<product>
+		const auto first = hid_id.find(':');
+		const auto second = hid_id.find(':', first + 1);
+		if(first == std::string::npos || second == std::string::npos)
+		{
+			return std::nullopt;
+		}
+
+		const auto id = std::string_view(hid_id);
+		const auto bus = parse_hex(id.substr(0, first));
+		const auto vendor = parse_hex(id.substr(first + 1, second - first - 1));
+		const auto product = parse_hex(id.substr(second + 1));
+
+		if(vendor != VENDOR_ID || product != PRODUCT_ID || (bus != BUS_USB && bus != BUS_BLUETOOTH))
+		{
+			return std::nullopt;
+		}
+
+		return DeviceInfo{
+				(std::filesystem::path("/dev") / node_name).string(),
+				std::move(hid_uniq),
+				"",
+				std::move(hid_name),
+				bus == BUS_USB ? ConnectionType::USB : ConnectionType::BLUETOOTH,
+				Backend::HIDRAW
+		};
+	}
+
+	std::vector<DeviceInfo> hidraw::enumerate()
+	{
+		std::vector<DeviceInfo> devices;
+
+		std::error_code error;
+		for(const auto& entry: std::filesystem::directory_iterator("/sys/class/hidraw", error))
+		{
+			if(auto device_info = detail::read_hidraw_device_info(entry.path().filename().string()))
+			{
+				devices.push_back(std::move(*device_info));
+			}
+		}
+
+		return devices;
+	}
+}
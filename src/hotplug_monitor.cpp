@@ -0,0 +1,199 @@
+#include "dual_sense_hid/hotplug_monitor.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "dual_sense_hid/hidraw.hpp"
+#include "dual_sense_hid/detail/hidraw.hpp"
+#include "dual_sense_hid/detail/uevent.hpp"
+
+static constexpr unsigned int KERNEL_GROUP = 1;
+static constexpr unsigned int UDEV_GROUP = 2;
+
+
+namespace dual_sense_hid
+{
+	namespace
+	{
+		// anyone may send to netlink multicast group, only kernel or root-owned udev is trusted
+		bool trusted_sender(HotplugMonitor::Source source, const sockaddr_nl& sender, msghdr& message)
+		{
+			if(source == HotplugMonitor::Source::KERNEL)
+			{
+				return sender.nl_pid == 0;
+			}
+
+			const auto* control = CMSG_FIRSTHDR(&message);
+			if(control == nullptr || control->cmsg_level != SOL_SOCKET || control->cmsg_type != SCM_CREDENTIALS)
+			{
+				return false;
+			}
+
+			ucred credentials{};
+			std::memcpy(&credentials, CMSG_DATA(control), sizeof(credentials));
+
+			return sender.nl_pid != 0 && credentials.uid == 0;
+		}
+	}
+
+	HotplugMonitor::HotplugMonitor(Source source)
+		:socket_(::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT)), source_(source)
+	{
+		if(socket_ < 0)
+		{
+			throw std::runtime_error("Failed to open uevent socket");
+		}
+
+		const int enable = 1;
+		setsockopt(socket_, SOL_SOCKET, SO_PASSCRED, &enable, sizeof(enable));
+
+		sockaddr_nl address{};
+		address.nl_family = AF_NETLINK;
+		address.nl_groups = source == Source::KERNEL ? KERNEL_GROUP : UDEV_GROUP;
+		if(bind(socket_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			::close(socket_);
+			throw std::runtime_error("Failed to bind uevent socket");
+		}
+
+		// snapshot taken after bind, so nothing connected in between is missed
+		devices_ = hidraw::enumerate();
+	}
+
+	HotplugMonitor::~HotplugMonitor()
+	{
+		::close(socket_);
+	}
+
+	std::vector<HotplugEvent> HotplugMonitor::poll(std::chrono::milliseconds timeout)
+	{
+		std::vector<HotplugEvent> events;
+
+		const auto timeout_ms = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(
+				timeout.count(),
+				-1,
+				std::numeric_limits<int>::max()
+		));
+		pollfd descriptor{socket_, POLLIN, 0};
+		if(::poll(&descriptor, 1, timeout_ms) <= 0)
+		{
+			return events;
+		}
+
+		while(receive(events))
+		{}
+
+		return events;
+	}
+
+	const std::vector<DeviceInfo>& HotplugMonitor::devices() const
+	{
+		return devices_;
+	}
+
+	int HotplugMonitor::native_handle() const
+	{
+		return socket_;
+	}
+
+	bool HotplugMonitor::receive(std::vector<HotplugEvent>& events)
+	{
+		iovec data{buffer_.data(), buffer_.size()};
+		sockaddr_nl sender{};
+		alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(ucred))> control{};
+
+		msghdr message{};
+		message.msg_name = &sender;
+		message.msg_namelen = sizeof(sender);
+		message.msg_iov = &data;
+		message.msg_iovlen = 1;
+		message.msg_control = control.data();
+		message.msg_controllen = control.size();
+
+		const auto received = ::recvmsg(socket_, &message, MSG_DONTWAIT);
+		if(received < 0)
+		{
+			switch(errno)
+			{
+				case EINTR:
+					return true;
+				case ENOBUFS:
+					resynchronize(events);
+					return true;
+				case EAGAIN:
+					return false;
+				default:
+					throw std::runtime_error("Failed to receive uevent");
+			}
+		}
+
+		if((message.msg_flags & MSG_TRUNC) != 0 || !trusted_sender(source_, sender, message))
+		{
+			return true;
+		}
+
+		if(const auto uevent = detail::parse_uevent(std::span(buffer_.data(), static_cast<size_t>(received))))
+		{
+			handle(*uevent, events);
+		}
+
+		return true;
+	}
+
+	void HotplugMonitor::handle(const detail::Uevent& uevent, std::vector<HotplugEvent>& events)
+	{
+		if(uevent.subsystem != "hidraw" || uevent.devname.empty())
+		{
+			return;
+		}
+
+		const auto path = "/dev/" + std::string(uevent.devname);
+		const auto known = std::ranges::find(devices_, path, &DeviceInfo::path);
+
+		if(uevent.action == "add" && known == devices_.end())
+		{
+			// sysfs is already populated when uevent is sent; non-DualSense nodes are filtered here
+			if(auto device_info = detail::read_hidraw_device_info(uevent.devname))
+			{
+				devices_.push_back(*device_info);
+				events.push_back({HotplugEvent::Action::ADDED, std::move(*device_info)});
+			}
+		}
+		else if(uevent.action == "remove" && known != devices_.end())
+		{
+			events.push_back({HotplugEvent::Action::REMOVED, std::move(*known)});
+			devices_.erase(known);
+		}
+	}
+
+	void HotplugMonitor::resynchronize(std::vector<HotplugEvent>& events)
+	{
+		auto current = hidraw::enumerate();
+
+		for(const auto& device_info: devices_)
+		{
+			if(std::ranges::find(current, device_info.path, &DeviceInfo::path) == current.end())
+			{
+				events.push_back({HotplugEvent::Action::REMOVED, device_info});
+			}
+		}
+		for(const auto& device_info: current)
+		{
+			if(std::ranges::find(devices_, device_info.path, &DeviceInfo::path) == devices_.end())
+			{
+				events.push_back({HotplugEvent::Action::ADDED, device_info});
+			}
+		}
+
+		devices_ = std::move(current);
+	}
+}
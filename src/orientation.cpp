@@ -0,0 +1,313 @@
+#include "dual_sense_hid/orientation.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <numbers>
+
+#include "dual_sense_hid/calibration.hpp"
+
+// longer gaps (e.g. paused reading) would make single integration step meaningless
+static constexpr uint64_t MAX_DT_US = 100000;
+
+
+namespace dual_sense_hid
+{
+	namespace
+	{
+		constexpr float GYRO_TO_RAD = std::numbers::pi_v<float> / (180.0f * Calibration::GYROSCOPE_RESOLUTION);
+
+		using Fixed = int64_t;
+
+		constexpr int FRACTION_BITS = FixedMadgwickFilter::FRACTION_BITS;
+		constexpr Fixed ONE = Fixed{1} << FRACTION_BITS;
+
+		// round(2^28 * pi / (180 * 1024))
+		constexpr Fixed GYRO_TO_RAD_FIXED = 4575;
+
+		inline Fixed mul(Fixed a, Fixed b)
+		{
+			return (a * b) >> FRACTION_BITS;
+		}
+
+		inline uint64_t isqrt(uint64_t value)
+		{
+			if(value < 2)
+			{
+				return value;
+			}
+
+			// Newton iteration from above converges monotonically
+			auto root = uint64_t{1} << ((std::bit_width(value) + 1) / 2);
+			while(true)
+			{
+				const auto next = (root + value / root) >> 1;
+				if(next >= root)
+				{
+					return root;
+				}
+				root = next;
+			}
+		}
+
+		/**
+		 * @brief Normalize vector of arbitrary scale to Q2.28 unit vector
+		 * @return false if vector is zero
+		 */
+		inline bool normalize(std::array<Fixed, 4>& vector)
+		{
+			Fixed magnitude = 0;
+			for(const auto value: vector)
+			{
+				magnitude = std::max(magnitude, std::abs(value));
+			}
+			if(magnitude == 0)
+			{
+				return false;
+			}
+
+			// keep squares sum within 64 bits
+			const auto shift = std::max(0, static_cast<int>(std::bit_width(static_cast<uint64_t>(magnitude))) - 30);
+
+			uint64_t squares = 0;
+			for(const auto value: vector)
+			{
+				const auto reduced = value >> shift;
+				squares += static_cast<uint64_t>(reduced * reduced);
+			}
+
+			const auto norm = static_cast<Fixed>(isqrt(squares)) << shift;
+
+			// |value| <= norm, so product with reciprocal fits 2^56
+			const auto reciprocal = (Fixed{1} << (2 * FRACTION_BITS)) / norm;
+			for(auto& value: vector)
+			{
+				value = (value * reciprocal) >> FRACTION_BITS;
+			}
+
+			return true;
+		}
+
+		inline bool normalize(std::array<float, 4>& vector)
+		{
+			const auto squares = vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2] + vector[3] * vector[3];
+			if(squares == 0.0f)
+			{
+				return false;
+			}
+
+			const auto inverse_norm = 1.0f / std::sqrt(squares);
+			for(auto& value: vector)
+			{
+				value *= inverse_norm;
+			}
+
+			return true;
+		}
+	}
+
+	MadgwickFilter::MadgwickFilter(float beta)
+		:beta_(beta)
+	{}
+
+	void MadgwickFilter::update(const State& state)
+	{
+		const auto timestamp = state.timestamps.sensor;
+		if(!initialized_)
+		{
+			initialized_ = true;
+			last_timestamp_ = timestamp;
+			return;
+		}
+
+		const auto dt_us = timestamp - last_timestamp_;
+		last_timestamp_ = timestamp;
+
+		update(state.gyro, state.acceleration, dt_us);
+	}
+
+	void MadgwickFilter::update(const State::Gyro& gyro, const State::Acceleration& acceleration, uint64_t dt_us)
+	{
+		const auto gx = static_cast<float>(gyro.pitch) * GYRO_TO_RAD;
+		const auto gy = static_cast<float>(gyro.yaw) * GYRO_TO_RAD;
+		const auto gz = static_cast<float>(gyro.roll) * GYRO_TO_RAD;
+
+		const auto [q0, q1, q2, q3] = orientation_;
+
+		// rate of change from gyroscope
+		std::array<float, 4> derivative = {
+				0.5f * (-q1 * gx - q2 * gy - q3 * gz),
+				0.5f * (q0 * gx + q2 * gz - q3 * gy),
+				0.5f * (q0 * gy - q1 * gz + q3 * gx),
+				0.5f * (q0 * gz + q1 * gy - q2 * gx)
+		};
+
+		std::array<float, 4> accel = {
+				static_cast<float>(acceleration.x),
+				static_cast<float>(acceleration.y),
+				static_cast<float>(acceleration.z),
+				0.0f
+		};
+		if(normalize(accel))
+		{
+			const auto [ax, ay, az, unused] = accel;
+
+			const auto q0q0 = q0 * q0;
+			const auto q1q1 = q1 * q1;
+			const auto q2q2 = q2 * q2;
+			const auto q3q3 = q3 * q3;
+
+			// gradient descent step towards gravity direction
+			std::array<float, 4> step = {
+					4.0f * q0 * q2q2 + 2.0f * q2 * ax + 4.0f * q0 * q1q1 - 2.0f * q1 * ay,
+					4.0f * q1 * q3q3 - 2.0f * q3 * ax + 4.0f * q0q0 * q1 - 2.0f * q0 * ay - 4.0f * q1
+						+ 8.0f * q1 * q1q1 + 8.0f * q1 * q2q2 + 4.0f * q1 * az,
+					4.0f * q0q0 * q2 + 2.0f * q0 * ax + 4.0f * q2 * q3q3 - 2.0f * q3 * ay - 4.0f * q2
+						+ 8.0f * q2 * q1q1 + 8.0f * q2 * q2q2 + 4.0f * q2 * az,
+					4.0f * q1q1 * q3 - 2.0f * q1 * ax + 4.0f * q2q2 * q3 - 2.0f * q2 * ay
+			};
+			if(normalize(step))
+			{
+				for(size_t i = 0; i < derivative.size(); ++i)
+				{
+					derivative[i] -= beta_ * step[i];
+				}
+			}
+		}
+
+		const auto dt = static_cast<float>(std::min(dt_us, MAX_DT_US)) * 1e-6f;
+
+		std::array<float, 4> integrated = {
+				q0 + derivative[0] * dt,
+				q1 + derivative[1] * dt,
+				q2 + derivative[2] * dt,
+				q3 + derivative[3] * dt
+		};
+		if(normalize(integrated))
+		{
+			orientation_ = {integrated[0], integrated[1], integrated[2], integrated[3]};
+		}
+	}
+
+	const Quaternion& MadgwickFilter::orientation() const
+	{
+		return orientation_;
+	}
+
+	void MadgwickFilter::reset()
+	{
+		orientation_ = {};
+		initialized_ = false;
+		last_timestamp_ = 0;
+	}
+
+	FixedMadgwickFilter::FixedMadgwickFilter(int32_t beta)
+		:beta_(beta), orientation_{static_cast<int32_t>(ONE), 0, 0, 0}
+	{}
+
+	void FixedMadgwickFilter::update(const State& state)
+	{
+		const auto timestamp = state.timestamps.sensor;
+		if(!initialized_)
+		{
+			initialized_ = true;
+			last_timestamp_ = timestamp;
+			return;
+		}
+
+		const auto dt_us = timestamp - last_timestamp_;
+		last_timestamp_ = timestamp;
+
+		update(state.gyro, state.acceleration, dt_us);
+	}
+
+	void FixedMadgwickFilter::update(const State::Gyro& gyro, const State::Acceleration& acceleration, uint64_t dt_us)
+	{
+		const Fixed gx = gyro.pitch * GYRO_TO_RAD_FIXED;
+		const Fixed gy = gyro.yaw * GYRO_TO_RAD_FIXED;
+		const Fixed gz = gyro.roll * GYRO_TO_RAD_FIXED;
+
+		const Fixed q0 = orientation_[0];
+		const Fixed q1 = orientation_[1];
+		const Fixed q2 = orientation_[2];
+		const Fixed q3 = orientation_[3];
+
+		// rate of change from gyroscope
+		std::array<Fixed, 4> derivative = {
+				(-mul(q1, gx) - mul(q2, gy) - mul(q3, gz)) / 2,
+				(mul(q0, gx) + mul(q2, gz) - mul(q3, gy)) / 2,
+				(mul(q0, gy) - mul(q1, gz) + mul(q3, gx)) / 2,
+				(mul(q0, gz) + mul(q1, gy) - mul(q2, gx)) / 2
+		};
+
+		std::array<Fixed, 4> accel = {acceleration.x, acceleration.y, acceleration.z, 0};
+		if(normalize(accel))
+		{
+			const auto [ax, ay, az, unused] = accel;
+
+			const auto q0q0 = mul(q0, q0);
+			const auto q1q1 = mul(q1, q1);
+			const auto q2q2 = mul(q2, q2);
+			const auto q3q3 = mul(q3, q3);
+
+			// gradient descent step towards gravity direction
+			std::array<Fixed, 4> step = {
+					4 * mul(q0, q2q2) + 2 * mul(q2, ax) + 4 * mul(q0, q1q1) - 2 * mul(q1, ay),
+					4 * mul(q1, q3q3) - 2 * mul(q3, ax) + 4 * mul(q0q0, q1) - 2 * mul(q0, ay) - 4 * q1
+						+ 8 * mul(q1, q1q1) + 8 * mul(q1, q2q2) + 4 * mul(q1, az),
+					4 * mul(q0q0, q2) + 2 * mul(q0, ax) + 4 * mul(q2, q3q3) - 2 * mul(q3, ay) - 4 * q2
+						+ 8 * mul(q2, q1q1) + 8 * mul(q2, q2q2) + 4 * mul(q2, az),
+					4 * mul(q1q1, q3) - 2 * mul(q1, ax) + 4 * mul(q2q2, q3) - 2 * mul(q2, ay)
+			};
+			if(normalize(step))
+			{
+				for(size_t i = 0; i < derivative.size(); ++i)
+				{
+					derivative[i] -= mul(beta_, step[i]);
+				}
+			}
+		}
+
+		const auto dt = static_cast<Fixed>((std::min(dt_us, MAX_DT_US) << FRACTION_BITS) / 1000000);
+
+		std::array<Fixed, 4> integrated = {
+				q0 + mul(derivative[0], dt),
+				q1 + mul(derivative[1], dt),
+				q2 + mul(derivative[2], dt),
+				q3 + mul(derivative[3], dt)
+		};
+		if(normalize(integrated))
+		{
+			for(size_t i = 0; i < orientation_.size(); ++i)
+			{
+				orientation_[i] = static_cast<int32_t>(integrated[i]);
+			}
+		}
+	}
+
+	const std::array<int32_t, 4>& FixedMadgwickFilter::raw_orientation() const
+	{
+		return orientation_;
+	}
+
+	Quaternion FixedMadgwickFilter::orientation() const
+	{
+		constexpr auto scale = 1.0f / static_cast<float>(ONE);
+
+		return
+			{
+				static_cast<float>(orientation_[0]) * scale,
+				static_cast<float>(orientation_[1]) * scale,
+				static_cast<float>(orientation_[2]) * scale,
+				static_cast<float>(orientation_[3]) * scale
+			};
+	}
+
+	void FixedMadgwickFilter::reset()
+	{
+		orientation_ = {static_cast<int32_t>(ONE), 0, 0, 0};
+		initialized_ = false;
+		last_timestamp_ = 0;
+	}
+}
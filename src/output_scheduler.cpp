@@ -0,0 +1,43 @@
+#include "dual_sense_hid/output_scheduler.hpp"
+
+
+namespace dual_sense_hid
+{
+	OutputScheduler::OutputScheduler(Gamepad& gamepad, const OutputSchedulerConfig& config)
+		:gamepad_(gamepad),
+		interval_(gamepad.connection_type() == ConnectionType::USB ? config.usb_interval : config.bluetooth_interval)
+	{}
+
+	bool OutputScheduler::tick(Clock::time_point now)
+	{
+		if(now < next_flush())
+		{
+			return false;
+		}
+
+		return flush(now);
+	}
+
+	bool OutputScheduler::flush(Clock::time_point now)
+	{
+		if(!gamepad_.push_state())
+		{
+			return false;
+		}
+
+		last_flush_ = now;
+
+		return true;
+	}
+
+	OutputScheduler::Clock::time_point OutputScheduler::next_flush() const
+	{
+		// avoid overflow before first flush
+		return last_flush_ == Clock::time_point::min() ? last_flush_ : last_flush_ + interval_;
+	}
+
+	std::chrono::microseconds OutputScheduler::interval() const
+	{
+		return interval_;
+	}
+}
@@ -0,0 +1,540 @@
+#include "dual_sense_hid/uring_reader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "dual_sense_hid/detail/report_input.hpp"
+
+static constexpr int RUN_TIMEOUT_MS = 100;
+
+static constexpr uint64_t POLL_TAG = 1;
+
+
+namespace dual_sense_hid
+{
+	namespace
+	{
+		inline unsigned load_acquire(const unsigned* value)
+		{
+			return std::atomic_ref(*const_cast<unsigned*>(value)).load(std::memory_order_acquire);
+		}
+
+		inline void store_release(unsigned* value, unsigned new_value)
+		{
+			std::atomic_ref(*value).store(new_value, std::memory_order_release);
+		}
+
+		template<typename T>
+		inline T* at_offset(void* base, uint32_t offset)
+		{
+			return reinterpret_cast<T*>(static_cast<uint8_t*>(base) + offset);
+		}
+
+		/**
+		 * @brief Run function when leaving scope, also by exception
+		 */
+		template<typename F>
+		class ScopeExit
+		{
+		public:
+			explicit ScopeExit(F function)
+				:function_(std::move(function))
+			{}
+
+			ScopeExit(const ScopeExit&) = delete;
+			ScopeExit& operator=(const ScopeExit&) = delete;
+
+			~ScopeExit()
+			{
+				function_();
+			}
+
+		private:
+			F function_;
+		};
+
+		inline size_t report_size(ConnectionType connection_type)
+		{
+			return connection_type == ConnectionType::USB ? sizeof(detail::ReportUSB) : sizeof(detail::ReportBT);
+		}
+	}
+
+	struct UringReader::Entry
+	{
+		Gamepad* gamepad;
+		bool use_calibration_data;
+
+		bool in_flight = false;
+		bool dispatching = false;
+		bool removed = false;
+
+		alignas(8) std::array<uint8_t, sizeof(detail::ReportBT)> buffer{};
+	};
+
+	struct UringReader::Ring
+	{
+		int fd = -1;
+		unsigned features = 0;
+
+		void* sq_ring = MAP_FAILED;
+		size_t sq_ring_size = 0;
+		void* cq_ring = MAP_FAILED;
+		size_t cq_ring_size = 0;
+		io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+		size_t sqes_size = 0;
+
+		unsigned* sq_head = nullptr;
+		unsigned* sq_tail = nullptr;
+		unsigned sq_mask = 0;
+		unsigned sq_entries = 0;
+		unsigned* sq_array = nullptr;
+
+		unsigned* cq_head = nullptr;
+		unsigned* cq_tail = nullptr;
+		unsigned cq_mask = 0;
+		io_uring_cqe* cqes = nullptr;
+
+		unsigned to_submit = 0;
+
+		Ring(const Ring&) = delete;
+		Ring& operator=(const Ring&) = delete;
+
+		explicit Ring(unsigned queue_depth)
+		{
+			io_uring_params params{};
+			fd = static_cast<int>(syscall(__NR_io_uring_setup, queue_depth, &params));
+			if(fd < 0)
+			{
+				return;
+			}
+			features = params.features;
+
+			sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			if((features & IORING_FEAT_SINGLE_MMAP) != 0)
+			{
+				sq_ring_size = std::max(sq_ring_size, cq_ring_size);
+				cq_ring_size = sq_ring_size;
+			}
+
+			sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+			if(sq_ring == MAP_FAILED)
+			{
+				return;
+			}
+
+			if((features & IORING_FEAT_SINGLE_MMAP) != 0)
+			{
+				cq_ring = sq_ring;
+			}
+			else
+			{
+				cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+				if(cq_ring == MAP_FAILED)
+				{
+					return;
+				}
+			}
+
+			sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+			sqes = static_cast<io_uring_sqe*>(
+					mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES)
+			);
+			if(sqes == MAP_FAILED)
+			{
+				return;
+			}
+
+			sq_head = at_offset<unsigned>(sq_ring, params.sq_off.head);
+			sq_tail = at_offset<unsigned>(sq_ring, params.sq_off.tail);
+			sq_mask = *at_offset<unsigned>(sq_ring, params.sq_off.ring_mask);
+			sq_entries = *at_offset<unsigned>(sq_ring, params.sq_off.ring_entries);
+			sq_array = at_offset<unsigned>(sq_ring, params.sq_off.array);
+
+			cq_head = at_offset<unsigned>(cq_ring, params.cq_off.head);
+			cq_tail = at_offset<unsigned>(cq_ring, params.cq_off.tail);
+			cq_mask = *at_offset<unsigned>(cq_ring, params.cq_off.ring_mask);
+			cqes = at_offset<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+		}
+
+		~Ring()
+		{
+			if(sqes != MAP_FAILED)
+			{
+				munmap(sqes, sqes_size);
+			}
+			if(cq_ring != MAP_FAILED && cq_ring != sq_ring)
+			{
+				munmap(cq_ring, cq_ring_size);
+			}
+			if(sq_ring != MAP_FAILED)
+			{
+				munmap(sq_ring, sq_ring_size);
+			}
+			if(fd >= 0)
+			{
+				::close(fd);
+			}
+		}
+
+		[[nodiscard]] bool usable() const
+		{
+			// timeouts of io_uring_enter are required to implement run_once
+			return fd >= 0 && sqes != MAP_FAILED && (features & IORING_FEAT_EXT_ARG) != 0;
+		}
+
+		/**
+		 * @brief Make sure next count entries fit in submission queue, so linked entries are submitted together
+		 */
+		void reserve(unsigned count)
+		{
+			if(*sq_tail - load_acquire(sq_head) + count > sq_entries)
+			{
+				enter(0, -1);
+			}
+		}
+
+		io_uring_sqe& next_sqe()
+		{
+			const auto tail = *sq_tail;
+			const auto index = tail & sq_mask;
+			sq_array[index] = index;
+
+			auto& sqe = sqes[index];
+			std::memset(&sqe, 0, sizeof(sqe));
+
+			store_release(sq_tail, tail + 1);
+			++to_submit;
+
+			return sqe;
+		}
+
+		/**
+		 * @brief Submit queued entries and wait for at least min_complete completions
+		 * @return false if syscall failed for other reason than timeout or interruption
+		 */
+		bool enter(unsigned min_complete, int timeout_ms)
+		{
+			__kernel_timespec timeout{};
+			timeout.tv_sec = timeout_ms / 1000;
+			timeout.tv_nsec = (timeout_ms % 1000) * 1000000ll;
+
+			io_uring_getevents_arg arg{};
+			arg.sigmask_sz = _NSIG / 8;
+			arg.ts = timeout_ms >= 0 ? reinterpret_cast<uint64_t>(&timeout) : 0;
+
+			const auto result = min_complete > 0
+					? syscall(__NR_io_uring_enter, fd, to_submit, min_complete, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg))
+					: syscall(__NR_io_uring_enter, fd, to_submit, 0, 0, nullptr, 0);
+			if(result < 0)
+			{
+				return errno == ETIME || errno == EINTR || errno == EBUSY;
+			}
+
+			to_submit -= static_cast<unsigned>(result);
+			return true;
+		}
+	};
+
+	UringReader::UringReader(Callback callback, DisconnectCallback disconnect_callback, unsigned queue_depth)
+		:callback_(std::move(callback)), disconnect_callback_(std::move(disconnect_callback))
+	{
+		ring_ = std::make_unique<Ring>(queue_depth);
+		if(!ring_->usable())
+		{
+			ring_.reset();
+			fallback_ = std::make_unique<GamepadHub>(callback_, disconnect_callback_);
+		}
+	}
+
+	UringReader::~UringReader()
+	{
+		if(!ring_)
+		{
+			return;
+		}
+
+		// kernel may still write into buffers of in-flight reads, so they are freed only after completion
+		for(const auto& entry: entries_)
+		{
+			// removed entries have cancellation queued already
+			if(entry->in_flight && !entry->removed)
+			{
+				cancel(*entry);
+			}
+		}
+
+		const auto in_flight = [this]()
+		{
+			return std::ranges::any_of(
+					entries_,
+					[](const std::unique_ptr<Entry>& entry)
+					{
+						return entry->in_flight;
+					}
+			);
+		};
+
+		while(in_flight())
+		{
+			if(!ring_->enter(1, -1))
+			{
+				// completion can't be awaited, leaking buffers is the only safe option
+				for(auto& entry: entries_)
+				{
+					if(entry->in_flight)
+					{
+						static_cast<void>(entry.release());
+					}
+				}
+				break;
+			}
+
+			auto head = *ring_->cq_head;
+			const auto tail = load_acquire(ring_->cq_tail);
+			for(; head != tail; ++head)
+			{
+				const auto user_data = ring_->cqes[head & ring_->cq_mask].user_data;
+				if(user_data != 0 && (user_data & POLL_TAG) == 0)
+				{
+					reinterpret_cast<Entry*>(user_data)->in_flight = false;
+				}
+			}
+			store_release(ring_->cq_head, head);
+		}
+
+		ring_.reset();
+		entries_.clear();
+	}
+
+	bool UringReader::uses_io_uring() const
+	{
+		return ring_ != nullptr;
+	}
+
+	void UringReader::add(Gamepad& gamepad, bool use_calibration_data)
+	{
+		if(fallback_)
+		{
+			fallback_->add(gamepad, use_calibration_data);
+			return;
+		}
+
+		if(gamepad.native_handle() < 0)
+		{
+			throw std::invalid_argument("Gamepad doesn't expose pollable handle (hidraw backend required)");
+		}
+		if(gamepad.is_reader_running())
+		{
+			throw std::logic_error("Gamepad with running reader thread can't be added to reader");
+		}
+
+		if(use_calibration_data)
+		{
+			gamepad.get_calibration_data();
+		}
+
+		auto& entry = *entries_.emplace_back(std::make_unique<Entry>(&gamepad, use_calibration_data));
+		submit_read(entry);
+	}
+
+	void UringReader::remove(Gamepad& gamepad)
+	{
+		if(fallback_)
+		{
+			fallback_->remove(gamepad);
+			return;
+		}
+
+		const auto it = std::ranges::find_if(
+				entries_,
+				[&gamepad](const std::unique_ptr<Entry>& entry)
+				{
+					return entry->gamepad == &gamepad && !entry->removed;
+				}
+		);
+		if(it == entries_.end())
+		{
+			return;
+		}
+
+		auto& entry = **it;
+		entry.removed = true;
+
+		if(entry.dispatching)
+		{
+			// released by run_once after callback returns
+			return;
+		}
+		if(!entry.in_flight)
+		{
+			release(entry);
+			return;
+		}
+
+		// buffer must stay alive until canceled read completes
+		cancel(entry);
+	}
+
+	void UringReader::cancel(Entry& entry)
+	{
+		ring_->reserve(2);
+		for(const auto user_data: {reinterpret_cast<uint64_t>(&entry) | POLL_TAG, reinterpret_cast<uint64_t>(&entry)})
+		{
+			auto& sqe = ring_->next_sqe();
+			sqe.opcode = IORING_OP_ASYNC_CANCEL;
+			sqe.fd = -1;
+			sqe.addr = user_data;
+			sqe.user_data = 0;
+		}
+	}
+
+	std::size_t UringReader::run_once(std::chrono::milliseconds timeout)
+	{
+		if(fallback_)
+		{
+			return fallback_->run_once(timeout);
+		}
+
+		const auto timeout_ms = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(
+				timeout.count(),
+				-1,
+				std::numeric_limits<int>::max()
+		));
+		if(!ring_->enter(timeout_ms != 0 ? 1 : 0, timeout_ms))
+		{
+			throw std::runtime_error("Failed to submit io_uring requests");
+		}
+
+		std::size_t dispatched = 0;
+
+		auto head = *ring_->cq_head;
+		const auto tail = load_acquire(ring_->cq_tail);
+		// head is advanced before completion is handled, so one thrown from callback isn't dispatched again
+		const ScopeExit consume(
+				[this, &head]()
+				{
+					store_release(ring_->cq_head, head);
+				}
+		);
+		while(head != tail)
+		{
+			const auto cqe = ring_->cqes[head & ring_->cq_mask];
+			++head;
+
+			if(cqe.user_data == 0 || (cqe.user_data & POLL_TAG) != 0)
+			{
+				// cancel requests and polls: failed poll fails linked read too, which is handled below
+				continue;
+			}
+
+			auto& entry = *reinterpret_cast<Entry*>(cqe.user_data);
+			entry.in_flight = false;
+
+			if(entry.removed)
+			{
+				release(entry);
+				continue;
+			}
+
+			if(cqe.res > 0 && static_cast<size_t>(cqe.res) >= report_size(entry.gamepad->connection_type()))
+			{
+				const ScopeExit finish(
+						[this, &entry]()
+						{
+							entry.dispatching = false;
+							if(entry.removed)
+							{
+								release(entry);
+							}
+							else
+							{
+								submit_read(entry);
+							}
+						}
+				);
+				entry.dispatching = true;
+
+				const auto state = entry.gamepad->process_raw_report(entry.buffer.data(), entry.use_calibration_data);
+				callback_(*entry.gamepad, state);
+				++dispatched;
+			}
+			else if(cqe.res > 0 || cqe.res == -EAGAIN || cqe.res == -EINTR || cqe.res == -ECANCELED)
+			{
+				// short read would leave rest of report from previous one, so it is skipped
+				submit_read(entry);
+			}
+			else
+			{
+				auto& gamepad = *entry.gamepad;
+				release(entry);
+
+				if(disconnect_callback_)
+				{
+					disconnect_callback_(gamepad);
+				}
+			}
+		}
+
+		return dispatched;
+	}
+
+	void UringReader::run(const std::stop_token& stop_token)
+	{
+		while(!stop_token.stop_requested())
+		{
+			run_once(std::chrono::milliseconds(RUN_TIMEOUT_MS));
+		}
+	}
+
+	void UringReader::submit_read(Entry& entry)
+	{
+		const auto fd = entry.gamepad->native_handle();
+		const auto user_data = reinterpret_cast<uint64_t>(&entry);
+
+		// hidraw descriptors are non-blocking, so readiness is awaited by linked poll
+		ring_->reserve(2);
+
+		auto& poll = ring_->next_sqe();
+		poll.opcode = IORING_OP_POLL_ADD;
+		poll.fd = fd;
+		poll.poll32_events = POLLIN;
+		// no IOSQE_CQE_SKIP_SUCCESS - with it canceled chain doesn't complete read, so buffer could never be freed
+		poll.flags = IOSQE_IO_LINK;
+		poll.user_data = user_data | POLL_TAG;
+
+		auto& read = ring_->next_sqe();
+		read.opcode = IORING_OP_READ;
+		read.fd = fd;
+		read.addr = reinterpret_cast<uint64_t>(entry.buffer.data());
+		read.len = static_cast<uint32_t>(entry.buffer.size());
+		read.off = std::numeric_limits<uint64_t>::max();
+		read.user_data = user_data;
+
+		entry.in_flight = true;
+	}
+
+	void UringReader::release(Entry& entry)
+	{
+		std::erase_if(
+				entries_,
+				[&entry](const std::unique_ptr<Entry>& current)
+				{
+					return current.get() == &entry;
+				}
+		);
+	}
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <vector>
+
+#include <dual_sense_hid/gamepad.hpp>
+
+#include "pipe_device.hpp"
+
+using namespace dual_sense_hid;
+
+namespace
+{
+	struct Task
+	{
+		struct promise_type
+		{
+			Task get_return_object()
+			{
+				return {};
+			}
+
+			std::suspend_never initial_suspend() noexcept
+			{
+				return {};
+			}
+
+			std::suspend_never final_suspend() noexcept
+			{
+				return {};
+			}
+
+			void return_void()
+			{}
+
+			void unhandled_exception()
+			{
+				std::terminate();
+			}
+		};
+	};
+
+	Task await_state(Gamepad& gamepad, std::optional<State>& result, Executor executor = {})
+	{
+		result = co_await gamepad.next_state(std::move(executor));
+	}
+
+	Task await_change(Gamepad& gamepad, uint32_t buttons, std::optional<State>& result)
+	{
+		result = co_await gamepad.next_change(buttons);
+	}
+
+	// polls gamepad again from inside resumption, while another coroutine waits
+	Task await_and_poll(Gamepad& gamepad, std::optional<State>& result, std::optional<State>& nested_result)
+	{
+		result = co_await gamepad.next_state();
+
+		await_state(gamepad, nested_result);
+		EXPECT_TRUE(gamepad.try_poll(false).has_value());
+	}
+}
+
+TEST(awaitable, next_state_resumes_inline)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	std::optional<State> result;
+	await_state(gamepad, result);
+	EXPECT_FALSE(result.has_value());
+
+	device.send(neutral_report(42));
+	EXPECT_EQ(42, gamepad.poll(false).left_pad.x);
+
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(42, result->left_pad.x);
+}
+
+TEST(awaitable, next_state_resumes_through_executor)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	std::vector<std::coroutine_handle<>> scheduled;
+	std::optional<State> result;
+	await_state(
+			gamepad,
+			result,
+			[&scheduled](std::coroutine_handle<> handle)
+			{
+				scheduled.push_back(handle);
+			}
+	);
+
+	device.send(neutral_report(7));
+	EXPECT_EQ(7, gamepad.poll(false).left_pad.x);
+
+	ASSERT_EQ(1u, scheduled.size());
+	EXPECT_FALSE(result.has_value());
+
+	scheduled.front().resume();
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(7, result->left_pad.x);
+}
+
+TEST(awaitable, next_change_waits_for_button_edge)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	std::optional<State> result;
+	await_change(gamepad, button_mask(Button::CROSS), result);
+
+	device.send(neutral_report(10));
+	EXPECT_EQ(10, gamepad.poll(false).left_pad.x);
+	EXPECT_FALSE(result.has_value());
+
+	auto pressed = neutral_report(20);
+	pressed.buttons.cross = 1;
+	device.send(pressed);
+	EXPECT_TRUE(gamepad.poll(false).button_pad.cross);
+
+	ASSERT_TRUE(result.has_value());
+	EXPECT_TRUE(result->button_pad.cross);
+	EXPECT_EQ(20, result->left_pad.x);
+}
+
+TEST(awaitable, resumed_coroutine_polls_again)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	std::optional<State> result;
+	std::optional<State> nested_result;
+	await_and_poll(gamepad, result, nested_result);
+
+	device.send(neutral_report(1));
+	device.send(neutral_report(2));
+	EXPECT_EQ(1, gamepad.poll(false).left_pad.x);
+
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(1, result->left_pad.x);
+	ASSERT_TRUE(nested_result.has_value());
+	EXPECT_EQ(2, nested_result->left_pad.x);
+}
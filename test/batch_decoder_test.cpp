@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <dual_sense_hid/batch_decoder.hpp>
+#include <dual_sense_hid/raw_report.hpp>
+#include <dual_sense_hid/detail/report_input.hpp>
+
+using namespace dual_sense_hid;
+
+namespace
+{
+	struct Buffers
+	{
+		explicit Buffers(size_t count)
+			:motion(6, std::vector<int32_t>(count)), analog(6, std::vector<uint8_t>(count))
+		{}
+
+		MotionBatch batch()
+		{
+			return
+				{
+					motion[0], motion[1], motion[2], motion[3], motion[4], motion[5],
+					analog[0], analog[1], analog[2], analog[3], analog[4], analog[5]
+				};
+		}
+
+		std::vector<std::vector<int32_t>> motion;
+		std::vector<std::vector<uint8_t>> analog;
+	};
+
+	std::vector<uint8_t> random_reports(size_t count, size_t report_size)
+	{
+		std::mt19937 generator(42);
+		std::uniform_int_distribution<int> distribution(0, 255);
+
+		std::vector<uint8_t> reports(count * report_size);
+		for(auto& byte: reports)
+		{
+			byte = static_cast<uint8_t>(distribution(generator));
+		}
+
+		return reports;
+	}
+
+	Calibration make_calibration()
+	{
+		Calibration calibration{};
+
+		calibration.gyroscope = {(540 + 540) * Calibration::GYROSCOPE_RESOLUTION, 17596, -3, 17551, 11, 17635, -7};
+		calibration.accelerometer = {2 * Calibration::ACCELEROMETER_RESOLUTION, 16395, 33, 16387, 3, 16421, 101};
+
+		return calibration;
+	}
+}
+
+class batch_decoder: public testing::TestWithParam<ConnectionType>
+{};
+
+TEST_P(batch_decoder, matches_report_fields)
+{
+	const BatchDecoder decoder(GetParam());
+	const auto common_offset = GetParam() == ConnectionType::USB
+			? offsetof(detail::ReportUSB, common)
+			: offsetof(detail::ReportBT, common);
+
+	constexpr size_t count = 37;
+	const auto reports = random_reports(count, decoder.report_size());
+
+	Buffers buffers(count);
+	ASSERT_EQ(decoder.decode(reports, buffers.batch()), count);
+
+	for(size_t i = 0; i < count; ++i)
+	{
+		const auto& common = *reinterpret_cast<const detail::ReportCommon*>(
+				reports.data() + i * decoder.report_size() + common_offset
+		);
+
+		EXPECT_EQ(buffers.motion[0][i], detail::extract_axis(common.gyro_pitch));
+		EXPECT_EQ(buffers.motion[1][i], detail::extract_axis(common.gyro_yaw));
+		EXPECT_EQ(buffers.motion[2][i], detail::extract_axis(common.gyro_roll));
+		EXPECT_EQ(buffers.motion[3][i], detail::extract_axis(common.acceleration_x));
+		EXPECT_EQ(buffers.motion[4][i], detail::extract_axis(common.acceleration_y));
+		EXPECT_EQ(buffers.motion[5][i], detail::extract_axis(common.acceleration_z));
+		EXPECT_EQ(buffers.analog[0][i], common.left_pad_x);
+		EXPECT_EQ(buffers.analog[1][i], common.left_pad_y);
+		EXPECT_EQ(buffers.analog[2][i], common.right_pad_x);
+		EXPECT_EQ(buffers.analog[3][i], common.right_pad_y);
+		EXPECT_EQ(buffers.analog[4][i], common.left_trigger);
+		EXPECT_EQ(buffers.analog[5][i], common.right_trigger);
+	}
+}
+
+TEST_P(batch_decoder, simd_matches_scalar)
+{
+	if(!BatchDecoder::simd_supported())
+	{
+		GTEST_SKIP() << "AVX2 not supported";
+	}
+
+	const BatchDecoder decoder(GetParam());
+	const auto kernel = detail::CalibrationKernel::from_calibration(make_calibration());
+
+	constexpr size_t count = 64;
+	const auto reports = random_reports(count, decoder.report_size());
+	const auto common_offset = GetParam() == ConnectionType::USB
+			? offsetof(detail::ReportUSB, common)
+			: offsetof(detail::ReportBT, common);
+
+	for(const auto calibration: {static_cast<const detail::CalibrationKernel*>(nullptr), &kernel})
+	{
+		const detail::BatchLayout layout{reports.data() + common_offset, decoder.report_size(), calibration};
+
+		Buffers scalar(count);
+		detail::decode_batch_scalar(layout, 0, count, scalar.batch());
+
+		Buffers simd(count);
+		ASSERT_EQ(detail::decode_batch_avx2(layout, count, simd.batch()), count);
+
+		EXPECT_EQ(scalar.motion, simd.motion);
+		EXPECT_EQ(scalar.analog, simd.analog);
+	}
+}
+
+TEST(batch_decoder_buffers, too_small_buffers_rejected)
+{
+	const BatchDecoder decoder(ConnectionType::USB);
+	const auto reports = random_reports(4, decoder.report_size());
+
+	Buffers buffers(3);
+	EXPECT_THROW(decoder.decode(reports, buffers.batch()), std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(connection, batch_decoder, testing::Values(ConnectionType::USB, ConnectionType::BLUETOOTH));
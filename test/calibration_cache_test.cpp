@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+
+#include <dual_sense_hid/calibration_cache.hpp>
+
+using namespace dual_sense_hid;
+
+namespace
+{
+	Calibration make_calibration()
+	{
+		Calibration calibration{};
+
+		calibration.gyroscope = {(540 + 540) * Calibration::GYROSCOPE_RESOLUTION, 17596, -3, 17551, 11, 17635, -7};
+		calibration.accelerometer = {2 * Calibration::ACCELEROMETER_RESOLUTION, 16395, 33, 16387, -3, 16421, 101};
+
+		return calibration;
+	}
+
+	void expect_equal(const Calibration& expected, const Calibration& actual)
+	{
+		EXPECT_EQ(0, std::memcmp(&expected, &actual, sizeof(Calibration)));
+	}
+}
+
+class calibration_cache: public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		directory_ = std::filesystem::temp_directory_path()
+				/ ("dual_sense_hid_test_" + std::string(testing::UnitTest::GetInstance()->current_test_info()->name()));
+		std::filesystem::remove_all(directory_);
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove_all(directory_);
+	}
+
+	std::filesystem::path directory_;
+};
+
+TEST_F(calibration_cache, round_trip)
+{
+	const CalibrationCache cache(directory_);
+	const std::string serial = "a0:ab:51:12:34:56";
+
+	EXPECT_FALSE(cache.load(serial).has_value());
+	ASSERT_TRUE(cache.store(serial, make_calibration()));
+
+	const auto loaded = cache.load(serial);
+	ASSERT_TRUE(loaded.has_value());
+	expect_equal(make_calibration(), *loaded);
+
+	EXPECT_FALSE(cache.load("a0:ab:51:12:34:57").has_value());
+}
+
+TEST_F(calibration_cache, invalidate)
+{
+	const CalibrationCache cache(directory_);
+	ASSERT_TRUE(cache.store("serial", make_calibration()));
+
+	cache.invalidate("serial");
+	EXPECT_FALSE(cache.load("serial").has_value());
+}
+
+TEST_F(calibration_cache, corrupted_entry_rejected)
+{
+	const CalibrationCache cache(directory_);
+	ASSERT_TRUE(cache.store("serial", make_calibration()));
+
+	const auto path = directory_ / "serial.cal";
+	{
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(12);
+		file.put('\x7f');
+	}
+	EXPECT_FALSE(cache.load("serial").has_value());
+
+	std::filesystem::resize_file(path, 20);
+	EXPECT_FALSE(cache.load("serial").has_value());
+}
+
+TEST_F(calibration_cache, empty_serial_not_cached)
+{
+	const CalibrationCache cache(directory_);
+
+	EXPECT_FALSE(cache.store("", make_calibration()));
+	EXPECT_FALSE(cache.load("").has_value());
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include <dual_sense_hid/detail/calibration_kernel.hpp>
+
+using namespace dual_sense_hid;
+
+namespace
+{
+	Calibration make_calibration()
+	{
+		Calibration calibration{};
+
+		calibration.gyroscope.factor_numerator = (540 + 540) * Calibration::GYROSCOPE_RESOLUTION;
+		calibration.gyroscope.pitch_factor_denominator = 8794 + 8802;
+		calibration.gyroscope.pitch_offset = -3;
+		calibration.gyroscope.yaw_factor_denominator = 8771 + 8780;
+		calibration.gyroscope.yaw_offset = 11;
+		calibration.gyroscope.roll_factor_denominator = 8820 + 8815;
+		calibration.gyroscope.roll_offset = -7;
+
+		calibration.accelerometer.factor_numerator = 2 * Calibration::ACCELEROMETER_RESOLUTION;
+		calibration.accelerometer.x_factor_denominator = 8231 + 8164;
+		calibration.accelerometer.x_offset = 33;
+		calibration.accelerometer.y_factor_denominator = 8197 + 8190;
+		calibration.accelerometer.y_offset = 3;
+		calibration.accelerometer.z_factor_denominator = 8312 + 8109;
+		calibration.accelerometer.z_offset = 101;
+
+		return calibration;
+	}
+}
+
+TEST(calibration_kernel, matches_mult_frac)
+{
+	const auto calibration = make_calibration();
+	const auto kernel = detail::CalibrationKernel::from_calibration(calibration);
+
+	const auto& gyro = calibration.gyroscope;
+	const auto& accel = calibration.accelerometer;
+
+	// evaluated in 64 bits, since remainder times numerator overflows 32 bits for real gyroscope calibration
+	const auto reference = [](int64_t value, int64_t offset, int64_t numerator, int64_t denominator)
+	{
+		return detail::mult_frac(value - offset, numerator, denominator);
+	};
+
+	for(int32_t value = -32768; value <= 32767; ++value)
+	{
+		const auto calibrated = kernel.apply({value, value, value, value, value, value, 0, 0});
+
+		const std::array<int64_t, 6> expected = {
+				reference(value, gyro.pitch_offset, gyro.factor_numerator, gyro.pitch_factor_denominator),
+				reference(value, gyro.yaw_offset, gyro.factor_numerator, gyro.yaw_factor_denominator),
+				reference(value, gyro.roll_offset, gyro.factor_numerator, gyro.roll_factor_denominator),
+				reference(value, accel.x_offset, accel.factor_numerator, accel.x_factor_denominator),
+				reference(value, accel.y_offset, accel.factor_numerator, accel.y_factor_denominator),
+				reference(value, accel.z_offset, accel.factor_numerator, accel.z_factor_denominator)
+		};
+
+		for(size_t axis = 0; axis < expected.size(); ++axis)
+		{
+			ASSERT_LE(std::abs(calibrated[axis] - expected[axis]), 1) << "axis " << axis << ", value " << value;
+		}
+	}
+}
+
+TEST(calibration_kernel, zero_range_passes_through)
+{
+	auto calibration = make_calibration();
+	calibration.gyroscope.yaw_factor_denominator = 0;
+
+	const auto kernel = detail::CalibrationKernel::from_calibration(calibration);
+	const auto calibrated = kernel.apply({0, 1234, 0, 0, 0, 0, 0, 0});
+
+	EXPECT_EQ(calibrated[1], 1234);
+}
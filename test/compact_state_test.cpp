@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <dual_sense_hid/compact_state.hpp>
+#include <dual_sense_hid/detail/buttons.hpp>
+
+using namespace dual_sense_hid;
+
+namespace
+{
+	State make_state(State::DPadDirection direction)
+	{
+		return
+			{
+				{12, 250},
+				{0, 128},
+				{255, 3},
+				{17, 9},
+				direction,
+				{true, false, true, false},
+				{true, false, false, true, true, false, false, true, true, false, true},
+				{-120000, 4096, 2000000},
+				{-8192, 0, 16384},
+				31,
+				{true, 1919, 1079, 127},
+				{false, 0, 4095, 5},
+				{10, State::PowerStatus::CHARGING},
+				{true, false, true},
+				{0x1'0000'0123, 987654321, 200}
+			};
+	}
+
+	void expect_equal(const State& expected, const State& actual)
+	{
+		EXPECT_EQ(expected.left_pad.x, actual.left_pad.x);
+		EXPECT_EQ(expected.left_pad.y, actual.left_pad.y);
+		EXPECT_EQ(expected.right_pad.x, actual.right_pad.x);
+		EXPECT_EQ(expected.right_pad.y, actual.right_pad.y);
+
+		EXPECT_EQ(expected.left_trigger.value, actual.left_trigger.value);
+		EXPECT_EQ(expected.left_trigger.stop_location, actual.left_trigger.stop_location);
+		EXPECT_EQ(expected.right_trigger.value, actual.right_trigger.value);
+		EXPECT_EQ(expected.right_trigger.stop_location, actual.right_trigger.stop_location);
+
+		EXPECT_EQ(expected.dpad_direction, actual.dpad_direction);
+
+		EXPECT_EQ(expected.button_pad.triangle, actual.button_pad.triangle);
+		EXPECT_EQ(expected.button_pad.circle, actual.button_pad.circle);
+		EXPECT_EQ(expected.button_pad.cross, actual.button_pad.cross);
+		EXPECT_EQ(expected.button_pad.square, actual.button_pad.square);
+
+		EXPECT_EQ(expected.buttons.l1, actual.buttons.l1);
+		EXPECT_EQ(expected.buttons.r1, actual.buttons.r1);
+		EXPECT_EQ(expected.buttons.l2, actual.buttons.l2);
+		EXPECT_EQ(expected.buttons.r2, actual.buttons.r2);
+		EXPECT_EQ(expected.buttons.create, actual.buttons.create);
+		EXPECT_EQ(expected.buttons.menu, actual.buttons.menu);
+		EXPECT_EQ(expected.buttons.l3, actual.buttons.l3);
+		EXPECT_EQ(expected.buttons.r3, actual.buttons.r3);
+		EXPECT_EQ(expected.buttons.home, actual.buttons.home);
+		EXPECT_EQ(expected.buttons.touchpad, actual.buttons.touchpad);
+		EXPECT_EQ(expected.buttons.mute, actual.buttons.mute);
+
+		EXPECT_EQ(expected.gyro.pitch, actual.gyro.pitch);
+		EXPECT_EQ(expected.gyro.yaw, actual.gyro.yaw);
+		EXPECT_EQ(expected.gyro.roll, actual.gyro.roll);
+		EXPECT_EQ(expected.acceleration.x, actual.acceleration.x);
+		EXPECT_EQ(expected.acceleration.y, actual.acceleration.y);
+		EXPECT_EQ(expected.acceleration.z, actual.acceleration.z);
+
+		EXPECT_EQ(expected.temperature, actual.temperature);
+
+		for(const auto& [expected_point, actual_point]: {
+				std::pair{expected.touch_point_0, actual.touch_point_0},
+				std::pair{expected.touch_point_1, actual.touch_point_1}
+		})
+		{
+			EXPECT_EQ(expected_point.active, actual_point.active);
+			EXPECT_EQ(expected_point.x, actual_point.x);
+			EXPECT_EQ(expected_point.y, actual_point.y);
+			EXPECT_EQ(expected_point.id, actual_point.id);
+		}
+
+		EXPECT_EQ(expected.battery.level, actual.battery.level);
+		EXPECT_EQ(expected.battery.power_status, actual.battery.power_status);
+
+		EXPECT_EQ(expected.audio.muted, actual.audio.muted);
+		EXPECT_EQ(expected.audio.headphones_connected, actual.audio.headphones_connected);
+		EXPECT_EQ(expected.audio.microphone_connected, actual.audio.microphone_connected);
+
+		EXPECT_EQ(expected.timestamps.sensor, actual.timestamps.sensor);
+		EXPECT_EQ(expected.timestamps.host, actual.timestamps.host);
+		EXPECT_EQ(expected.timestamps.touch, actual.timestamps.touch);
+	}
+}
+
+TEST(compact_state, round_trip)
+{
+	for(uint8_t direction = 0; direction <= static_cast<uint8_t>(State::DPadDirection::NONE); ++direction)
+	{
+		const auto state = make_state(static_cast<State::DPadDirection>(direction));
+		const auto unpacked = CompactState::from_state(state).to_state();
+
+		expect_equal(state, unpacked);
+	}
+}
+
+TEST(compact_state, pressed)
+{
+	const auto compact = CompactState::from_state(make_state(State::DPadDirection::DOWN_LEFT));
+
+	EXPECT_TRUE(compact.pressed(Button::DPAD_DOWN));
+	EXPECT_TRUE(compact.pressed(Button::DPAD_LEFT));
+	EXPECT_FALSE(compact.pressed(Button::DPAD_UP));
+	EXPECT_TRUE(compact.pressed(Button::TRIANGLE));
+	EXPECT_FALSE(compact.pressed(Button::CIRCLE));
+	EXPECT_TRUE(compact.pressed(Button::L1));
+	EXPECT_TRUE(compact.pressed(Button::MUTE));
+	EXPECT_FALSE(compact.pressed(Button::TOUCHPAD));
+}
+
+TEST(compact_state, report_button_mask_matches_state)
+{
+	detail::ReportButtons report{};
+	report.dpad = static_cast<uint8_t>(State::DPadDirection::UP_LEFT);
+	report.triangle = 1;
+	report.r2 = 1;
+	report.r3 = 1;
+	report.mute = 1;
+
+	auto state = make_state(State::DPadDirection::UP_LEFT);
+	state.button_pad = {true, false, false, false};
+	state.buttons = {false, false, false, true, false, false, false, true, false, false, true};
+
+	EXPECT_EQ(CompactState::from_state(state).buttons, detail::button_mask(report));
+}
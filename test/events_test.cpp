@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <dual_sense_hid/events.hpp>
+
+using namespace dual_sense_hid;
+
+TEST(events, filtering_and_thresholds)
+{
+	std::vector<Event> received;
+
+	detail::Subscription subscription{
+			1,
+			{
+				event_mask(Event::Type::BUTTON_PRESSED) | event_mask(Event::Type::LEFT_STICK_MOVED) | event_mask(Event::Type::TOUCH_BEGIN),
+				button_mask(Button::CROSS),
+				10,
+				4
+			},
+			[&received](const Event& event, const State&)
+			{
+				received.push_back(event);
+			}
+	};
+
+	State previous{};
+	previous.left_pad = {128, 128};
+
+	State current = previous;
+	current.left_pad = {135, 128};
+	current.touch_point_1.active = true;
+
+	subscription.dispatch(previous, previous, 0, 0);
+	EXPECT_TRUE(received.empty());
+
+	subscription.dispatch(previous, current, button_mask(Button::CROSS) | button_mask(Button::L1), button_mask(Button::R1));
+	ASSERT_EQ(2u, received.size());
+	EXPECT_EQ(Event::Type::BUTTON_PRESSED, received[0].type);
+	EXPECT_EQ(button_mask(Button::CROSS), received[0].buttons);
+	EXPECT_EQ(Event::Type::TOUCH_BEGIN, received[1].type);
+	EXPECT_EQ(1, received[1].touch_point);
+
+	received.clear();
+	previous = current;
+	current.left_pad = {139, 128};
+	subscription.dispatch(previous, current, 0, 0);
+	ASSERT_EQ(1u, received.size());
+	EXPECT_EQ(Event::Type::LEFT_STICK_MOVED, received[0].type);
+
+	received.clear();
+	previous = current;
+	current.left_pad = {145, 128};
+	subscription.dispatch(previous, current, 0, 0);
+	EXPECT_TRUE(received.empty());
+}
+
+TEST(events, all_events_mask)
+{
+	EXPECT_EQ(0x1ffu, ALL_EVENTS);
+	EXPECT_NE(0u, ALL_EVENTS & event_mask(Event::Type::LAST));
+	EXPECT_EQ(0u, ALL_EVENTS & (event_mask(Event::Type::LAST) << 1));
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include <dual_sense_hid/gamepad_hub.hpp>
+
+#include "pipe_device.hpp"
+
+using namespace dual_sense_hid;
+using namespace std::chrono_literals;
+
+TEST(gamepad_hub, dispatches_reports)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	std::vector<uint8_t> received;
+	GamepadHub hub(
+			[&received, &gamepad](Gamepad& source, const State& state)
+			{
+				EXPECT_EQ(&gamepad, &source);
+				received.push_back(state.left_pad.x);
+			}
+	);
+	hub.add(gamepad, false);
+
+	EXPECT_EQ(0u, hub.run_once(0ms));
+
+	device.send(neutral_report(3));
+	EXPECT_EQ(1u, hub.run_once(100ms));
+	ASSERT_EQ(1u, received.size());
+	EXPECT_EQ(3, received.front());
+
+	hub.remove(gamepad);
+	device.send(neutral_report(4));
+	EXPECT_EQ(0u, hub.run_once(0ms));
+	EXPECT_EQ(1u, received.size());
+}
+
+TEST(gamepad_hub, callback_exception_keeps_gamepad)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	bool disconnected = false;
+	bool fail = true;
+	size_t calls = 0;
+	GamepadHub hub(
+			[&fail, &calls](Gamepad&, const State&)
+			{
+				++calls;
+				if(fail)
+				{
+					throw std::runtime_error("callback failure");
+				}
+			},
+			[&disconnected](Gamepad&)
+			{
+				disconnected = true;
+			}
+	);
+	hub.add(gamepad, false);
+
+	device.send(neutral_report());
+	EXPECT_THROW(hub.run_once(100ms), std::runtime_error);
+	EXPECT_FALSE(disconnected);
+
+	fail = false;
+	device.send(neutral_report());
+	EXPECT_EQ(1u, hub.run_once(100ms));
+	EXPECT_EQ(2u, calls);
+	EXPECT_FALSE(disconnected);
+}
+
+TEST(gamepad_hub, subscriber_exception_keeps_gamepad)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	bool disconnected = false;
+	size_t calls = 0;
+	GamepadHub hub(
+			[&calls](Gamepad&, const State&)
+			{
+				++calls;
+			},
+			[&disconnected](Gamepad&)
+			{
+				disconnected = true;
+			}
+	);
+	hub.add(gamepad, false);
+
+	gamepad.subscribe(
+			[](const Event&, const State&)
+			{
+				throw std::runtime_error("subscriber failure");
+			},
+			{event_mask(Event::Type::LEFT_STICK_MOVED)}
+	);
+
+	device.send(neutral_report());
+	EXPECT_EQ(1u, hub.run_once(100ms));
+
+	device.send(neutral_report(0x10));
+	EXPECT_THROW(hub.run_once(100ms), std::runtime_error);
+	EXPECT_FALSE(disconnected);
+
+	device.send(neutral_report(0x10));
+	EXPECT_EQ(1u, hub.run_once(100ms));
+	EXPECT_EQ(2u, calls);
+	EXPECT_FALSE(disconnected);
+}
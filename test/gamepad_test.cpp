@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <dual_sense_hid/gamepad.hpp>
+
+#include "pipe_device.hpp"
+
+using namespace dual_sense_hid;
+using namespace std::chrono_literals;
+
+namespace
+{
+	std::optional<State> wait_for_state(Gamepad& gamepad)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + 1s;
+		while(std::chrono::steady_clock::now() < deadline)
+		{
+			if(auto state = gamepad.pop_state())
+			{
+				return state;
+			}
+			std::this_thread::sleep_for(1ms);
+		}
+
+		return std::nullopt;
+	}
+
+	SubscriptionId subscribe_throwing(Gamepad& gamepad)
+	{
+		return gamepad.subscribe(
+				[](const Event&, const State&)
+				{
+					throw std::runtime_error("subscriber failure");
+				},
+				{event_mask(Event::Type::LEFT_STICK_MOVED)}
+		);
+	}
+}
+
+TEST(gamepad, subscriber_exception_reaches_poll_after_all_subscribers)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	subscribe_throwing(gamepad);
+	size_t calls = 0;
+	gamepad.subscribe(
+			[&calls](const Event&, const State&)
+			{
+				++calls;
+			},
+			{event_mask(Event::Type::LEFT_STICK_MOVED)}
+	);
+
+	device.send(neutral_report());
+	EXPECT_TRUE(gamepad.try_poll(false).has_value());
+
+	device.send(neutral_report(0x10));
+	EXPECT_THROW(static_cast<void>(gamepad.try_poll(false)), std::runtime_error);
+	EXPECT_EQ(1u, calls);
+	ASSERT_TRUE(gamepad.latest_state().has_value());
+	EXPECT_EQ(0x10, gamepad.latest_state()->left_pad.x);
+}
+
+TEST(gamepad, reader_survives_subscriber_exception)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	subscribe_throwing(gamepad);
+	gamepad.start_reader(false);
+
+	for(const uint8_t x: std::vector<uint8_t>{0x80, 0x10, 0x70})
+	{
+		device.send(neutral_report(x));
+
+		const auto state = wait_for_state(gamepad);
+		ASSERT_TRUE(state.has_value());
+		EXPECT_EQ(x, state->left_pad.x);
+	}
+	EXPECT_TRUE(gamepad.is_reader_running());
+
+	gamepad.stop_reader();
+}
+
+TEST(gamepad, push_state_skips_unchanged_state)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	EXPECT_TRUE(gamepad.push_state());
+	EXPECT_EQ(1u, device.written().size());
+
+	EXPECT_FALSE(gamepad.push_state());
+	EXPECT_TRUE(device.written().empty());
+
+	// setting current value doesn't count as change
+	gamepad.lights().set_mute_light_mode(Gamepad::Lights::MuteLightMode::OFF);
+	EXPECT_FALSE(gamepad.push_state());
+	EXPECT_TRUE(device.written().empty());
+}
+
+TEST(gamepad, push_state_enables_changed_sections_only)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	EXPECT_TRUE(gamepad.push_state());
+	device.drain();
+
+	gamepad.lights().set_touchpad_light_color(1, 2, 3);
+	gamepad.lights().set_mute_light_mode(Gamepad::Lights::MuteLightMode::ON);
+	EXPECT_TRUE(gamepad.push_state());
+
+	const auto reports = device.written();
+	ASSERT_EQ(1u, reports.size());
+
+	const auto& report = reports.front();
+	EXPECT_EQ(0x02, report.report_id);
+	EXPECT_TRUE(report.common.enable_led_color_section);
+	EXPECT_TRUE(report.common.enable_mute_light_section);
+	EXPECT_FALSE(report.common.enable_player_indicators_section);
+	EXPECT_FALSE(report.common.enable_light_brightness_section);
+	EXPECT_FALSE(report.common.enable_color_light_fade_section);
+
+	EXPECT_EQ(1, report.common.touchpad_led_color.red_led);
+	EXPECT_EQ(2, report.common.touchpad_led_color.green_led);
+	EXPECT_EQ(3, report.common.touchpad_led_color.blue_led);
+	EXPECT_EQ(static_cast<uint8_t>(Gamepad::Lights::MuteLightMode::ON), report.common.power_save_mute.mute_light_mode);
+}
+
+TEST(gamepad, push_state_keeps_changes_after_failed_write)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	EXPECT_TRUE(gamepad.push_state());
+	device.drain();
+
+	gamepad.lights().set_player_indicator(Gamepad::Lights::PlayerIndicator::PLAYER_TWO);
+
+	device.fill();
+	EXPECT_FALSE(gamepad.push_state());
+	device.drain();
+
+	EXPECT_TRUE(gamepad.push_state());
+
+	const auto reports = device.written();
+	ASSERT_EQ(1u, reports.size());
+	EXPECT_TRUE(reports.front().common.enable_player_indicators_section);
+	EXPECT_FALSE(reports.front().common.enable_led_color_section);
+	EXPECT_TRUE(reports.front().common.player_led.led_2);
+	EXPECT_TRUE(reports.front().common.player_led.led_4);
+}
+
+TEST(gamepad, try_poll_returns_immediately_without_report)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	const auto start = std::chrono::steady_clock::now();
+	EXPECT_FALSE(gamepad.try_poll(false).has_value());
+	EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+}
+
+TEST(gamepad, poll_for_times_out)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	const auto start = std::chrono::steady_clock::now();
+	EXPECT_FALSE(gamepad.poll_for(20ms, false).has_value());
+	EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+
+	device.send(neutral_report(5));
+	const auto state = gamepad.poll_for(1s, false);
+	ASSERT_TRUE(state.has_value());
+	EXPECT_EQ(5, state->left_pad.x);
+}
+
+TEST(gamepad, poll_skips_short_reports)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	device.send(neutral_report(51), 10);
+	EXPECT_FALSE(gamepad.try_poll(false).has_value());
+
+	device.send(neutral_report(51), 10);
+	device.send(neutral_report(2));
+	const auto state = gamepad.try_poll(false);
+	ASSERT_TRUE(state.has_value());
+	EXPECT_EQ(2, state->left_pad.x);
+}
+
+TEST(gamepad, poll_latest_drains_queue)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	EXPECT_FALSE(gamepad.poll_latest(false).has_value());
+
+	for(uint8_t x = 1; x <= 4; ++x)
+	{
+		device.send(neutral_report(x));
+	}
+
+	const auto state = gamepad.poll_latest(false);
+	ASSERT_TRUE(state.has_value());
+	EXPECT_EQ(4, state->left_pad.x);
+
+	EXPECT_FALSE(gamepad.try_poll(false).has_value());
+}
+
+TEST(gamepad, poll_batch_is_capped_by_output_size)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	for(uint8_t x = 1; x <= 5; ++x)
+	{
+		device.send(neutral_report(x));
+	}
+
+	std::array<State, 3> states{};
+	ASSERT_EQ(3u, gamepad.poll_batch(states, false));
+	for(uint8_t i = 0; i < states.size(); ++i)
+	{
+		EXPECT_EQ(i + 1, states[i].left_pad.x);
+	}
+
+	// remaining reports stay queued
+	EXPECT_EQ(2u, gamepad.poll_batch(states, false));
+	EXPECT_EQ(4, states[0].left_pad.x);
+	EXPECT_EQ(5, states[1].left_pad.x);
+	EXPECT_EQ(0u, gamepad.poll_batch(states, false));
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <dual_sense_hid/gyro_bias.hpp>
+
+using namespace dual_sense_hid;
+
+namespace
+{
+	constexpr State::Acceleration GRAVITY = {0, 0, Calibration::ACCELEROMETER_RESOLUTION};
+
+	void feed(GyroBiasEstimator& estimator, const State::Gyro& gyro, size_t count, int32_t noise = 0)
+	{
+		for(size_t i = 0; i < count; ++i)
+		{
+			const auto offset = (i % 2 == 0) ? noise : -noise;
+			estimator.update({gyro.pitch + offset, gyro.yaw - offset, gyro.roll + offset}, GRAVITY);
+		}
+	}
+}
+
+TEST(gyro_bias, not_still_until_window_filled)
+{
+	GyroBiasEstimator estimator;
+	feed(estimator, {100, -50, 20}, GyroBiasEstimator::WINDOW_SIZE - 1);
+
+	EXPECT_FALSE(estimator.bias().still);
+	EXPECT_EQ(estimator.bias().bias.pitch, 0);
+}
+
+TEST(gyro_bias, estimates_bias_when_still)
+{
+	GyroBiasEstimator estimator;
+	feed(estimator, {100, -50, 20}, GyroBiasEstimator::WINDOW_SIZE, 300);
+
+	const auto bias = estimator.bias();
+	EXPECT_TRUE(bias.still);
+	EXPECT_EQ(bias.bias.pitch, 100);
+	EXPECT_EQ(bias.bias.yaw, -50);
+	EXPECT_EQ(bias.bias.roll, 20);
+
+	State::Gyro gyro = {100, -50, 20};
+	estimator.correct(gyro);
+	EXPECT_EQ(gyro.pitch, 0);
+	EXPECT_EQ(gyro.yaw, 0);
+	EXPECT_EQ(gyro.roll, 0);
+}
+
+TEST(gyro_bias, motion_keeps_previous_bias)
+{
+	GyroBiasEstimator estimator;
+	feed(estimator, {100, -50, 20}, GyroBiasEstimator::WINDOW_SIZE);
+
+	// noisy motion exceeds gyroscope threshold
+	feed(estimator, {5000, 0, 0}, GyroBiasEstimator::WINDOW_SIZE / 2, 20000);
+	EXPECT_FALSE(estimator.bias().still);
+	EXPECT_EQ(estimator.bias().bias.pitch, 100);
+
+	// steady rotation above max bias is not treated as bias
+	feed(estimator, {50 * Calibration::GYROSCOPE_RESOLUTION, 0, 0}, GyroBiasEstimator::WINDOW_SIZE);
+	EXPECT_FALSE(estimator.bias().still);
+	EXPECT_EQ(estimator.bias().bias.pitch, 100);
+}
+
+TEST(gyro_bias, tracks_drift)
+{
+	GyroBiasEstimator estimator;
+	feed(estimator, {100, 0, 0}, GyroBiasEstimator::WINDOW_SIZE);
+	feed(estimator, {180, 0, 0}, GyroBiasEstimator::WINDOW_SIZE);
+
+	EXPECT_TRUE(estimator.bias().still);
+	EXPECT_EQ(estimator.bias().bias.pitch, 180);
+}
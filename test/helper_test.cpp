@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+
+#include <dual_sense_hid/detail/helper.hpp>
+
+TEST(helper, wide_to_utf8)
+{
+	using dual_sense_hid::detail::wide_to_utf8;
+
+	EXPECT_EQ(wide_to_utf8(nullptr), "");
+	EXPECT_EQ(wide_to_utf8(L""), "");
+	EXPECT_EQ(wide_to_utf8(L"Sony Interactive Entertainment"), "Sony Interactive Entertainment");
+	EXPECT_EQ(wide_to_utf8(L"é€"), "\xc3\xa9\xe2\x82\xac");
+	EXPECT_EQ(wide_to_utf8(L"\U0001f3ae"), "\xf0\x9f\x8e\xae");
+}
+
+TEST(helper, wide_to_utf8_reuses_output)
+{
+	std::string output = "previous content";
+	const auto capacity = output.capacity();
+
+	dual_sense_hid::detail::wide_to_utf8(L"a0:b1:c2", output);
+	EXPECT_EQ(output, "a0:b1:c2");
+	EXPECT_EQ(output.capacity(), capacity);
+}
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include <dual_sense_hid/input_edges.hpp>
+
+using namespace dual_sense_hid;
+
+TEST(input_edges, press_hold_release)
+{
+	InputEdges edges;
+
+	edges.update(button_mask(Button::CROSS), 1000);
+	EXPECT_TRUE(edges.pressed(Button::CROSS));
+	EXPECT_TRUE(edges.held(Button::CROSS));
+	EXPECT_FALSE(edges.released(Button::CROSS));
+	EXPECT_EQ(0, edges.hold_duration(Button::CROSS).count());
+
+	edges.update(button_mask(Button::CROSS) | button_mask(Button::L1), 5000);
+	EXPECT_FALSE(edges.pressed(Button::CROSS));
+	EXPECT_TRUE(edges.pressed(Button::L1));
+	EXPECT_EQ(4000, edges.hold_duration(Button::CROSS).count());
+	EXPECT_EQ(0, edges.hold_duration(Button::L1).count());
+
+	edges.update(button_mask(Button::L1), 9000);
+	EXPECT_TRUE(edges.released(Button::CROSS));
+	EXPECT_FALSE(edges.held(Button::CROSS));
+	EXPECT_EQ(0, edges.hold_duration(Button::CROSS).count());
+	EXPECT_EQ(4000, edges.hold_duration(Button::L1).count());
+	EXPECT_EQ(button_mask(Button::CROSS), edges.released_mask());
+	EXPECT_EQ(0u, edges.pressed_mask());
+}
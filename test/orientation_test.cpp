@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numbers>
+
+#include <dual_sense_hid/calibration.hpp>
+#include <dual_sense_hid/orientation.hpp>
+
+using namespace dual_sense_hid;
+
+namespace
+{
+	constexpr uint64_t STEP_US = 1000;
+
+	// 90 deg/s around yaw axis with gravity along z
+	constexpr State::Gyro YAW_RATE = {0, 90 * Calibration::GYROSCOPE_RESOLUTION, 0};
+	constexpr State::Acceleration GRAVITY = {0, 0, Calibration::ACCELEROMETER_RESOLUTION};
+
+	void expect_near(const Quaternion& expected, const Quaternion& actual, float tolerance)
+	{
+		EXPECT_NEAR(expected.w, actual.w, tolerance);
+		EXPECT_NEAR(expected.x, actual.x, tolerance);
+		EXPECT_NEAR(expected.y, actual.y, tolerance);
+		EXPECT_NEAR(expected.z, actual.z, tolerance);
+	}
+}
+
+TEST(orientation, integrates_gyroscope)
+{
+	MadgwickFilter filter(0.0f);
+	for(int i = 0; i < 1000; ++i)
+	{
+		filter.update(YAW_RATE, GRAVITY, STEP_US);
+	}
+
+	const auto half_angle = std::numbers::pi_v<float> / 4.0f;
+	expect_near({std::cos(half_angle), 0.0f, std::sin(half_angle), 0.0f}, filter.orientation(), 1e-3f);
+}
+
+TEST(orientation, uses_sensor_timestamps)
+{
+	MadgwickFilter filter(0.0f);
+
+	State state{};
+	state.gyro = YAW_RATE;
+	state.acceleration = GRAVITY;
+
+	// first state only sets time base, then single 0.05s (50000 us) step
+	state.timestamps.sensor = 1000;
+	filter.update(state);
+	expect_near({}, filter.orientation(), 1e-6f);
+
+	state.timestamps.sensor += 50000;
+	filter.update(state);
+
+	const auto half_angle = std::numbers::pi_v<float> / 80.0f;
+	expect_near({std::cos(half_angle), 0.0f, std::sin(half_angle), 0.0f}, filter.orientation(), 1e-3f);
+}
+
+TEST(orientation, converges_to_gravity)
+{
+	// tilted 90 degrees around pitch axis: gravity along y
+	MadgwickFilter filter(0.5f);
+	for(int i = 0; i < 5000; ++i)
+	{
+		filter.update({0, 0, 0}, {0, Calibration::ACCELEROMETER_RESOLUTION, 0}, STEP_US);
+	}
+
+	const auto half_angle = std::numbers::pi_v<float> / 4.0f;
+	expect_near({std::cos(half_angle), std::sin(half_angle), 0.0f, 0.0f}, filter.orientation(), 1e-2f);
+}
+
+TEST(orientation, fixed_point_matches_float)
+{
+	MadgwickFilter filter;
+	FixedMadgwickFilter fixed_filter;
+
+	for(int i = 0; i < 2000; ++i)
+	{
+		const State::Gyro gyro = {(i % 7 - 3) * 2000, 90 * Calibration::GYROSCOPE_RESOLUTION, -(i % 5) * 1500};
+		const State::Acceleration acceleration = {i % 11 * 300, 4000, Calibration::ACCELEROMETER_RESOLUTION};
+
+		filter.update(gyro, acceleration, STEP_US);
+		fixed_filter.update(gyro, acceleration, STEP_US);
+	}
+
+	expect_near(filter.orientation(), fixed_filter.orientation(), 2e-3f);
+}
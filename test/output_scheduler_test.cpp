@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <dual_sense_hid/output_scheduler.hpp>
+
+#include "pipe_device.hpp"
+
+using namespace dual_sense_hid;
+
+TEST(output_scheduler, coalesces_changes_within_interval)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	OutputScheduler scheduler(gamepad);
+	EXPECT_EQ(OutputSchedulerConfig{}.usb_interval, scheduler.interval());
+
+	const auto start = OutputScheduler::Clock::now();
+	EXPECT_TRUE(scheduler.tick(start));
+	EXPECT_EQ(1u, device.written().size());
+	EXPECT_EQ(start + scheduler.interval(), scheduler.next_flush());
+
+	auto& lights = gamepad.lights();
+	lights.set_touchpad_light_color(10, 20, 30);
+	EXPECT_FALSE(scheduler.tick(start + scheduler.interval() / 2));
+	lights.set_player_indicator(Gamepad::Lights::PlayerIndicator::PLAYER_ONE);
+	lights.set_touchpad_light_color(40, 50, 60);
+	EXPECT_FALSE(scheduler.tick(scheduler.next_flush() - OutputScheduler::Clock::duration(1)));
+	EXPECT_TRUE(device.written().empty());
+
+	EXPECT_TRUE(scheduler.tick(scheduler.next_flush()));
+
+	const auto reports = device.written();
+	ASSERT_EQ(1u, reports.size());
+	EXPECT_TRUE(reports.front().common.enable_led_color_section);
+	EXPECT_TRUE(reports.front().common.enable_player_indicators_section);
+	EXPECT_EQ(40, reports.front().common.touchpad_led_color.red_led);
+
+	// nothing changed since last flush
+	EXPECT_FALSE(scheduler.tick(scheduler.next_flush()));
+	EXPECT_TRUE(device.written().empty());
+}
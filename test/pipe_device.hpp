@@ -0,0 +1,125 @@
+#ifndef DUAL_SENSE_HID_TEST_PIPE_DEVICE_HPP
+#define DUAL_SENSE_HID_TEST_PIPE_DEVICE_HPP
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <dual_sense_hid/device_info.hpp>
+#include <dual_sense_hid/detail/report_input.hpp>
+#include <dual_sense_hid/detail/report_output.hpp>
+
+
+/**
+ * @brief Pipe standing in for USB hidraw node
+ *
+ * Gamepad opens read end through /proc, so it reads reports sent here. Its own output
+ * reports land in the same pipe, so they have to be drained before sending input.
+ * Pipe is in packet mode, so like hidraw every read returns at most one report.
+ */
+class PipeDevice
+{
+public:
+	PipeDevice()
+	{
+		if(::pipe2(fds_.data(), O_CLOEXEC | O_NONBLOCK | O_DIRECT) != 0)
+		{
+			throw std::runtime_error("Failed to create pipe");
+		}
+	}
+
+	PipeDevice(const PipeDevice&) = delete;
+	PipeDevice& operator=(const PipeDevice&) = delete;
+
+	~PipeDevice()
+	{
+		::close(fds_[0]);
+		::close(fds_[1]);
+	}
+
+	[[nodiscard]] dual_sense_hid::DeviceInfo device_info() const
+	{
+		return {
+				"/proc/self/fd/" + std::to_string(fds_[0]),
+				"",
+				"",
+				"",
+				dual_sense_hid::ConnectionType::USB,
+				dual_sense_hid::Backend::HIDRAW
+		};
+	}
+
+	void drain()
+	{
+		std::array<uint8_t, 256> buffer{};
+		while(::read(fds_[0], buffer.data(), buffer.size()) > 0)
+		{}
+	}
+
+	/**
+	 * @brief Send input report, truncated to size bytes if given
+	 */
+	void send(const dual_sense_hid::detail::ReportCommon& common, size_t size = sizeof(dual_sense_hid::detail::ReportUSB))
+	{
+		dual_sense_hid::detail::ReportUSB report{};
+		report.report_id = 0x01;
+		report.common = common;
+
+		if(::write(fds_[1], &report, size) != static_cast<ssize_t>(size))
+		{
+			throw std::runtime_error("Failed to write report");
+		}
+	}
+
+	/**
+	 * @brief Take output reports written by gamepad
+	 */
+	std::vector<dual_sense_hid::detail::SetStateReportUSB> written()
+	{
+		std::vector<dual_sense_hid::detail::SetStateReportUSB> reports;
+
+		dual_sense_hid::detail::SetStateReportUSB report{};
+		while(::read(fds_[0], &report, sizeof(report)) == static_cast<ssize_t>(sizeof(report)))
+		{
+			reports.push_back(report);
+		}
+
+		return reports;
+	}
+
+	/**
+	 * @brief Fill pipe completely, so writes of gamepad fail until it is drained
+	 */
+	void fill()
+	{
+		std::array<uint8_t, 4096> buffer{};
+		while(::write(fds_[1], buffer.data(), buffer.size()) > 0)
+		{}
+		while(::write(fds_[1], buffer.data(), 1) > 0)
+		{}
+	}
+
+private:
+	std::array<int, 2> fds_{};
+};
+
+/**
+ * @brief Neutral report with given left stick X position
+ */
+inline dual_sense_hid::detail::ReportCommon neutral_report(uint8_t left_x = 0x80)
+{
+	dual_sense_hid::detail::ReportCommon common{};
+	common.left_pad_x = left_x;
+	common.left_pad_y = 0x80;
+	common.right_pad_x = 0x80;
+	common.right_pad_y = 0x80;
+	common.buttons.dpad = 8;
+
+	return common;
+}
+
+#endif //DUAL_SENSE_HID_TEST_PIPE_DEVICE_HPP
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <dual_sense_hid/detail/seqlock.hpp>
+
+namespace
+{
+	struct Payload
+	{
+		uint32_t values[9];
+	};
+}
+
+TEST(seqlock, empty_until_stored)
+{
+	dual_sense_hid::detail::Seqlock<Payload> slot;
+
+	Payload payload{};
+	EXPECT_FALSE(slot.load(payload));
+
+	payload.values[8] = 42;
+	slot.store(payload);
+
+	Payload loaded{};
+	EXPECT_TRUE(slot.load(loaded));
+	EXPECT_EQ(42u, loaded.values[8]);
+}
+
+TEST(seqlock, snapshots_are_not_torn)
+{
+	dual_sense_hid::detail::Seqlock<Payload> slot;
+	std::atomic<bool> done = false;
+
+	std::thread writer(
+			[&slot, &done]()
+			{
+				for(uint32_t i = 1; i <= 100000; ++i)
+				{
+					Payload payload;
+					for(auto& value: payload.values)
+					{
+						value = i;
+					}
+					slot.store(payload);
+				}
+				done.store(true);
+			}
+	);
+
+	while(!done.load())
+	{
+		Payload payload{};
+		if(slot.load(payload))
+		{
+			for(const auto value: payload.values)
+			{
+				ASSERT_EQ(payload.values[0], value);
+			}
+		}
+	}
+
+	writer.join();
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <dual_sense_hid/detail/spsc_ring.hpp>
+
+TEST(spsc_ring, fifo_order_and_capacity)
+{
+	dual_sense_hid::detail::SpscRing<int, 4> ring;
+
+	int value = 0;
+	EXPECT_FALSE(ring.try_pop(value));
+
+	for(int i = 0; i < 4; ++i)
+	{
+		EXPECT_TRUE(ring.try_push(i));
+	}
+	EXPECT_FALSE(ring.try_push(4));
+	EXPECT_EQ(4u, ring.size());
+
+	for(int i = 0; i < 4; ++i)
+	{
+		EXPECT_TRUE(ring.try_pop(value));
+		EXPECT_EQ(i, value);
+	}
+	EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(spsc_ring, concurrent_transfer)
+{
+	static constexpr int COUNT = 100000;
+	dual_sense_hid::detail::SpscRing<int, 64> ring;
+
+	std::thread producer(
+			[&ring]()
+			{
+				for(int i = 0; i < COUNT; ++i)
+				{
+					while(!ring.try_push(i))
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+	);
+
+	int expected = 0;
+	int value = 0;
+	while(expected < COUNT)
+	{
+		if(ring.try_pop(value))
+		{
+			// ASSERT would return with producer still joinable
+			EXPECT_EQ(expected, value);
+			++expected;
+		}
+	}
+
+	producer.join();
+}
@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+
+#include <dual_sense_hid/detail/timestamp.hpp>
+
+using dual_sense_hid::detail::TimestampExtender;
+
+TEST(timestamp_extender, starts_at_raw_value)
+{
+	TimestampExtender extender;
+
+	EXPECT_EQ(extender.extend(1000), 1000u);
+	EXPECT_EQ(extender.extend(4000), 4000u);
+}
+
+TEST(timestamp_extender, extends_past_wraparound)
+{
+	TimestampExtender extender;
+
+	extender.extend(0xffff'ff00);
+	EXPECT_EQ(extender.extend(0x0000'0100), 0x1'0000'0100u);
+	EXPECT_EQ(extender.extend(0xffff'ff00), 0x1'ffff'ff00u);
+	EXPECT_EQ(extender.extend(0x0000'0010), 0x2'0000'0010u);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <dual_sense_hid/detail/triple_buffer.hpp>
+
+TEST(triple_buffer, keeps_latest_value)
+{
+	dual_sense_hid::detail::TripleBuffer<int> mailbox;
+
+	EXPECT_EQ(nullptr, mailbox.try_take());
+	EXPECT_FALSE(mailbox.pending());
+
+	mailbox.back() = 1;
+	mailbox.publish();
+	EXPECT_TRUE(mailbox.pending());
+
+	mailbox.back() = 2;
+	mailbox.publish();
+
+	const auto* value = mailbox.try_take();
+	ASSERT_NE(nullptr, value);
+	EXPECT_EQ(2, *value);
+	EXPECT_FALSE(mailbox.pending());
+	EXPECT_EQ(nullptr, mailbox.try_take());
+}
+
+TEST(triple_buffer, close_after_pending_value)
+{
+	dual_sense_hid::detail::TripleBuffer<int> mailbox;
+
+	mailbox.back() = 7;
+	mailbox.publish();
+	mailbox.close();
+
+	const auto* value = mailbox.wait_take();
+	ASSERT_NE(nullptr, value);
+	EXPECT_EQ(7, *value);
+	EXPECT_EQ(nullptr, mailbox.wait_take());
+}
+
+TEST(triple_buffer, concurrent_transfer)
+{
+	static constexpr int COUNT = 100000;
+	dual_sense_hid::detail::TripleBuffer<int> mailbox;
+
+	std::thread producer(
+			[&mailbox]()
+			{
+				for(int i = 1; i <= COUNT; ++i)
+				{
+					mailbox.back() = i;
+					mailbox.publish();
+				}
+				mailbox.close();
+			}
+	);
+
+	int last = 0;
+	while(const auto* value = mailbox.wait_take())
+	{
+		EXPECT_GT(*value, last);
+		last = *value;
+	}
+	producer.join();
+
+	EXPECT_EQ(COUNT, last);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include <dual_sense_hid/detail/uevent.hpp>
+
+using namespace std::string_literals;
+
+namespace
+{
+	std::string udev_message(const std::string& properties)
+	{
+		std::string message(40, '\0');
+		std::memcpy(message.data(), "libudev", 7);
+
+		const unsigned char magic[] = {0xfe, 0xed, 0xca, 0xfe};
+		std::memcpy(message.data() + 8, magic, sizeof(magic));
+
+		const auto offset = static_cast<uint32_t>(message.size());
+		const auto length = static_cast<uint32_t>(properties.size());
+		std::memcpy(message.data() + 12, &offset, sizeof(offset));
+		std::memcpy(message.data() + 16, &offset, sizeof(offset));
+		std::memcpy(message.data() + 20, &length, sizeof(length));
+
+		message += properties;
+
+		return message;
+	}
+}
+
+TEST(uevent, kernel_message)
+{
+	const auto message = "add@/devices/virtual/hidraw3\0ACTION=add\0DEVPATH=/devices/virtual/hidraw3\0SUBSYSTEM=hidraw\0DEVNAME=hidraw3\0SEQNUM=42\0"s;
+
+	const auto uevent = dual_sense_hid::detail::parse_uevent(message);
+	ASSERT_TRUE(uevent.has_value());
+	EXPECT_EQ(uevent->action, "add");
+	EXPECT_EQ(uevent->subsystem, "hidraw");
+	EXPECT_EQ(uevent->devname, "hidraw3");
+}
+
+TEST(uevent, udev_message)
+{
+	const auto message = udev_message("ACTION=remove\0SUBSYSTEM=hidraw\0DEVNAME=/dev/hidraw7\0"s);
+
+	const auto uevent = dual_sense_hid::detail::parse_uevent(message);
+	ASSERT_TRUE(uevent.has_value());
+	EXPECT_EQ(uevent->action, "remove");
+	EXPECT_EQ(uevent->subsystem, "hidraw");
+	EXPECT_EQ(uevent->devname, "hidraw7");
+}
+
+TEST(uevent, without_devname)
+{
+	const auto message = "change@/devices/platform\0ACTION=change\0SUBSYSTEM=platform\0"s;
+
+	const auto uevent = dual_sense_hid::detail::parse_uevent(message);
+	ASSERT_TRUE(uevent.has_value());
+	EXPECT_TRUE(uevent->devname.empty());
+}
+
+TEST(uevent, malformed)
+{
+	EXPECT_FALSE(dual_sense_hid::detail::parse_uevent(""s).has_value());
+	EXPECT_FALSE(dual_sense_hid::detail::parse_uevent("no header\0ACTION=add\0SUBSYSTEM=hidraw\0"s).has_value());
+	EXPECT_FALSE(dual_sense_hid::detail::parse_uevent("add@/devices\0SUBSYSTEM=hidraw\0"s).has_value());
+
+	auto truncated = udev_message("ACTION=add\0SUBSYSTEM=hidraw\0"s);
+	truncated.resize(truncated.size() - 4);
+	EXPECT_FALSE(dual_sense_hid::detail::parse_uevent(truncated).has_value());
+
+	auto bad_magic = udev_message("ACTION=add\0SUBSYSTEM=hidraw\0"s);
+	bad_magic[8] = 0;
+	EXPECT_FALSE(dual_sense_hid::detail::parse_uevent(bad_magic).has_value());
+}
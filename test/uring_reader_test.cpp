@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include <dual_sense_hid/uring_reader.hpp>
+
+#include "pipe_device.hpp"
+
+using namespace dual_sense_hid;
+using namespace std::chrono_literals;
+
+TEST(uring_reader, dispatches_reports)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	std::vector<uint8_t> received;
+	UringReader reader(
+			[&received](Gamepad&, const State& state)
+			{
+				received.push_back(state.left_pad.x);
+			}
+	);
+	reader.add(gamepad, false);
+
+	for(uint8_t x = 1; x <= 3; ++x)
+	{
+		device.send(neutral_report(x));
+		EXPECT_EQ(1u, reader.run_once(1000ms));
+	}
+
+	EXPECT_EQ((std::vector<uint8_t>{1, 2, 3}), received);
+}
+
+TEST(uring_reader, remove_with_read_in_flight)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	size_t calls = 0;
+	UringReader reader(
+			[&calls](Gamepad&, const State&)
+			{
+				++calls;
+			}
+	);
+	reader.add(gamepad, false);
+
+	// read is submitted and waits for data
+	EXPECT_EQ(0u, reader.run_once(10ms));
+
+	reader.remove(gamepad);
+	EXPECT_EQ(0u, reader.run_once(10ms));
+
+	device.send(neutral_report());
+	EXPECT_EQ(0u, reader.run_once(10ms));
+	EXPECT_EQ(0u, calls);
+
+	// gamepad can be added again after removal
+	reader.add(gamepad, false);
+	EXPECT_EQ(1u, reader.run_once(1000ms));
+	EXPECT_EQ(1u, calls);
+}
+
+TEST(uring_reader, remove_from_callback)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	size_t calls = 0;
+	UringReader* reader_pointer = nullptr;
+	UringReader reader(
+			[&calls, &reader_pointer](Gamepad& source, const State&)
+			{
+				++calls;
+				reader_pointer->remove(source);
+			}
+	);
+	reader_pointer = &reader;
+	reader.add(gamepad, false);
+
+	device.send(neutral_report());
+	EXPECT_EQ(1u, reader.run_once(1000ms));
+
+	device.send(neutral_report());
+	EXPECT_EQ(0u, reader.run_once(10ms));
+	EXPECT_EQ(1u, calls);
+}
+
+TEST(uring_reader, destroyed_with_read_in_flight)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	{
+		UringReader reader([](Gamepad&, const State&) {});
+		reader.add(gamepad, false);
+		EXPECT_EQ(0u, reader.run_once(10ms));
+	}
+
+	// read canceled by destructor must not consume report
+	device.send(neutral_report(9));
+	const auto state = gamepad.try_poll(false);
+	ASSERT_TRUE(state.has_value());
+	EXPECT_EQ(9, state->left_pad.x);
+}
+
+TEST(uring_reader, skips_short_reads)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	std::vector<uint8_t> received;
+	UringReader reader(
+			[&received](Gamepad&, const State& state)
+			{
+				received.push_back(state.left_pad.x);
+			}
+	);
+	reader.add(gamepad, false);
+
+	device.send(neutral_report(51), 10);
+	EXPECT_EQ(0u, reader.run_once(10ms));
+
+	device.send(neutral_report(2));
+	EXPECT_EQ(1u, reader.run_once(1000ms));
+
+	EXPECT_EQ((std::vector<uint8_t>{2}), received);
+}
+
+TEST(uring_reader, callback_exception_dispatches_report_once)
+{
+	PipeDevice device;
+	Gamepad gamepad(device.device_info(), false);
+	device.drain();
+
+	std::vector<uint8_t> received;
+	UringReader reader(
+			[&received](Gamepad&, const State& state)
+			{
+				received.push_back(state.left_pad.x);
+				if(state.left_pad.x == 1)
+				{
+					throw std::runtime_error("callback failure");
+				}
+			}
+	);
+	reader.add(gamepad, false);
+
+	device.send(neutral_report(1));
+	EXPECT_THROW(static_cast<void>(reader.run_once(1000ms)), std::runtime_error);
+
+	// gamepad stays in reader and failed report isn't delivered again
+	device.send(neutral_report(2));
+	EXPECT_EQ(1u, reader.run_once(1000ms));
+
+	EXPECT_EQ((std::vector<uint8_t>{1, 2}), received);
+}